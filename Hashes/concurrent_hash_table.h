@@ -0,0 +1,158 @@
+/*
+ * @file
+ * Содержит реализацию потокобезопасной хэш-таблицы, разбитой на сегменты
+ */
+
+#pragma once
+
+#include "hash_table.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+
+
+namespace study
+{
+
+/**
+ * @brief Потокобезопасная хэш-таблица из нескольких независимых сегментов (shards).
+ * @details Сегмент выбирается по старшим битам перемешанного хэша ключа; у каждого
+ * сегмента своя study::HashTable и своя блокировка чтения-записи, поэтому потоки,
+ * работающие с разными сегментами, не мешают друг другу, а читатели одного
+ * сегмента не мешают друг другу.
+ * Ссылки на значения наружу не отдаются: после снятия блокировки их мог бы
+ * инвалидировать rehash(). Вместо этого значения либо копируются (equal_range),
+ * либо обрабатываются под блокировкой (visit).
+ * Ключ хэшируется один раз: по хэшу выбирается сегмент, и он же передается в таблицу
+ * сегмента. Таблицы сегментов используют ту же хэш-функцию с постоянным зерном.
+ * @tparam Hash функтор хэширования ключа, как у study::HashTable
+ */
+template <typename Key, typename T, typename Hash = std::hash<Key>>
+class ConcurrentHashTable
+{
+public:
+    using hash_function = Hash;
+
+    static constexpr unsigned max_shard_bits = 16;
+
+    /**
+     * @param[in] f хэш-функция
+     * @param[in] shard_bits логарифм числа сегментов, не больше max_shard_bits
+     * @throw std::invalid_argument, если shard_bits больше max_shard_bits
+     */
+    explicit ConcurrentHashTable(hash_function f = hash_function(), unsigned shard_bits = 6)
+        : hasher_(f),
+          shard_bits_(checked_shard_bits(shard_bits)),
+          shards_(std::make_unique<Shard[]>(std::size_t(1) << shard_bits_))
+    {
+        for (std::size_t i = 0; i < shard_count(); ++i)
+            shards_[i].table = HashTable<Key, T, Hash>(f);
+    }
+
+    /**
+     * @brief Вставляет элемент с ключом и значением в хэш-таблицу
+     * @param[in] key
+     * @param[in] value
+     */
+    void emplace(const Key& key, T value)
+    {
+        const std::size_t hash = hash_code(key);
+        Shard& shard = shards_[shard_index(hash)];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.table.emplace(key, hash, std::move(value));
+    }
+
+    /**
+     * @brief Вызывает f для списка значений по ключу, удерживая блокировку на чтение
+     * @param[in] key ключ, по которому осуществляется поиск
+     * @param[in] f функция, принимающая const std::list<T>&
+     * @return true, если ключ найден и f была вызвана
+     */
+    template <typename K, typename F, typename = enable_if_lookup_key<K, Key, Hash>>
+    bool visit(const K& key, F f) const
+    {
+        const std::size_t hash = hash_code(key);
+        const Shard& shard = shards_[shard_index(hash)];
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        const std::list<T>* values = shard.table.find(key, hash);
+        if (!values)
+            return false;
+        f(*values);
+        return true;
+    }
+
+    /**
+     * @brief Ищет в таблице все элементы, соответствующие ключу
+     * @param[in] key ключ, по которому осуществляется поиск
+     * @return копия списка значений типа T, которые хранятся по ключу key
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    std::list<T> equal_range(const K& key) const
+    {
+        std::list<T> result;
+        visit(key, [&result](const std::list<T>& values) { result = values; });
+        return result;
+    }
+
+    /**
+     * @brief Проверяет, есть ли ключ в таблице
+     * @param[in] key
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    bool contains(const K& key) const
+    {
+        const std::size_t hash = hash_code(key);
+        const Shard& shard = shards_[shard_index(hash)];
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.table.contains(key, hash);
+    }
+
+    std::size_t shard_count() const { return std::size_t(1) << shard_bits_; }
+
+private:
+
+    /**
+     * @brief Сегмент таблицы. Выравнивание по строке кэша, чтобы блокировки
+     * соседних сегментов не делили одну строку (false sharing).
+     */
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex mutex;
+        HashTable<Key, T, Hash> table;
+    };
+
+    /**
+     * @brief Выбирает сегмент по старшим битам хэша
+     * @details Хэш перемешивается умножением Фибоначчи: у слабых хэш-функций старшие
+     * биты часто нулевые, и без перемешивания все ключи попали бы в один сегмент.
+     */
+    std::size_t shard_index(std::size_t hash) const
+    {
+        if (shard_bits_ == 0)
+            return 0;
+        const std::uint64_t mixed = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(mixed >> (64 - shard_bits_));
+    }
+
+    template <typename K>
+    std::size_t hash_code(const K& key) const { return static_cast<std::size_t>(hasher_(key)); }
+
+    static unsigned checked_shard_bits(unsigned shard_bits)
+    {
+        if (shard_bits > max_shard_bits)
+            throw std::invalid_argument("ConcurrentHashTable: too many shard bits");
+        return shard_bits;
+    }
+
+    hash_function hasher_;
+    unsigned shard_bits_;
+    std::unique_ptr<Shard[]> shards_;
+};
+
+} //namespace study
@@ -32,11 +32,11 @@ public:
         , sport_(std::move(sport))
     {}
 
-    Name    getName()   const { return name_; }
-    Age     getAge()    const { return age_; }
-    Height  getHeight() const { return height_; }
-    Weight  getWeight() const { return weight_; }
-    Sport   getSport()  const { return sport_; }
+    const Name&  getName()   const { return name_; }
+    Age          getAge()    const { return age_; }
+    Height       getHeight() const { return height_; }
+    Weight       getWeight() const { return weight_; }
+    const Sport& getSport()  const { return sport_; }
 
     /**
      * @brief Выводит члены класса в заданный поток вывода в формате csv с заданным разделителем
@@ -0,0 +1,86 @@
+/**
+ * @file
+ * Содержит определения методов класса EntryReader
+ */
+
+#include "entry_reader.h"
+#include "functions.h"
+#include <cstring>
+#include <stdexcept>
+
+EntryReader::EntryReader(const std::string& filename, char sep, std::size_t buffer_size)
+    : file_(filename, std::ios::binary)
+    , sep_(sep)
+    , buffer_(buffer_size)
+{
+    if (!file_.is_open())
+        throw std::runtime_error("Cannot open input csv-file");
+    if (buffer_size == 0)
+        throw std::invalid_argument("EntryReader: buffer size must be positive");
+}
+
+bool EntryReader::next_line(const char*& first, const char*& last)
+{
+    while (true)
+    {
+        const char* begin = buffer_.data() + pos_;
+        const char* end = buffer_.data() + end_;
+        const void* newline = std::memchr(begin, '\n', end_ - pos_);
+        if (newline)
+        {
+            first = begin;
+            last = static_cast<const char*>(newline);
+            pos_ = static_cast<std::size_t>(last - buffer_.data()) + 1;
+            return true;
+        }
+        if (eof_)
+        {
+            // Последняя строка без '\n'
+            if (pos_ == end_)
+                return false;
+            first = begin;
+            last = end;
+            pos_ = end_;
+            return true;
+        }
+
+        // Недочитанная строка переносится в начало буфера, остаток буфера заполняется из файла
+        if (pos_ == 0 && end_ == buffer_.size())
+            throw std::runtime_error("EntryReader: line is longer than the read buffer");
+        std::memmove(buffer_.data(), begin, end_ - pos_);
+        end_ -= pos_;
+        pos_ = 0;
+        file_.read(buffer_.data() + end_, static_cast<std::streamsize>(buffer_.size() - end_));
+        // Ошибка чтения -- не конец файла: иначе проход молча закончился бы на середине
+        if (file_.bad())
+            throw std::runtime_error("EntryReader: cannot read input csv-file");
+        const std::size_t count = static_cast<std::size_t>(file_.gcount());
+        end_ += count;
+        bytes_read_ += count;
+        if (count == 0)
+            eof_ = true;
+    }
+}
+
+const Entry* EntryReader::next()
+{
+    const char* first;
+    const char* last;
+    if (!next_line(first, last))
+    {
+        entry_.reset();
+        return nullptr;
+    }
+    entry_.emplace(entry_from_csv_line(first, last, sep_));
+    return &*entry_;
+}
+
+std::size_t EntryReader::read_batch(std::vector<Entry>& batch, std::size_t max_count)
+{
+    batch.clear();
+    const char* first;
+    const char* last;
+    while (batch.size() < max_count && next_line(first, last))
+        batch.push_back(entry_from_csv_line(first, last, sep_));
+    return batch.size();
+}
@@ -0,0 +1,127 @@
+/**
+ * @file
+ * Содержит потоковое чтение записей из csv-файла с буфером фиксированного размера
+ */
+
+#pragma once
+
+#include "entry.h"
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+/**
+ * @brief Читает записи из csv-файла по одной, не загружая файл целиком
+ * @details Файл читается блоками в буфер фиксированного размера; строка, разрезанная
+ * границей блока, переносится в начало буфера и дочитывается. Память не зависит от
+ * размера файла: буфер и одна текущая запись. Формат и ошибки те же, что у
+ * data_from_csv_mmap; строка длиннее буфера и ошибка чтения файла -- std::runtime_error.
+ * Записи можно перебирать однопроходным итератором (begin/end), получать по одной
+ * (next) или пачками (read_batch).
+ */
+class EntryReader
+{
+public:
+    /**
+     * @brief Однопроходный итератор по записям
+     */
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = Entry;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const Entry*;
+        using reference         = const Entry&;
+
+        /**
+         * @brief Копия записи, на которую указывал итератор до постфиксного ++, для выражения *it++
+         */
+        class postfix_proxy
+        {
+        public:
+            explicit postfix_proxy(const Entry& entry) : entry_(entry) {}
+            const Entry& operator*() const { return entry_; }
+
+        private:
+            Entry entry_;
+        };
+
+        iterator() = default;
+        explicit iterator(EntryReader* reader) : reader_(reader), entry_(reader->next()) {}
+
+        reference operator*() const { return *entry_; }
+        pointer operator->() const { return entry_; }
+        iterator& operator++() { entry_ = reader_->next(); return *this; }
+        postfix_proxy operator++(int)
+        {
+            postfix_proxy previous(*entry_);
+            ++*this;
+            return previous;
+        }
+
+        friend bool operator==(const iterator& lhs, const iterator& rhs) { return lhs.entry_ == rhs.entry_; }
+        friend bool operator!=(const iterator& lhs, const iterator& rhs) { return lhs.entry_ != rhs.entry_; }
+
+    private:
+        EntryReader* reader_ = nullptr;
+        const Entry* entry_ = nullptr;
+    };
+
+    /**
+     * @brief Открывает файл для чтения
+     * @param[in] filename имя/путь к csv-файлу
+     * @param[in] sep использующийся в csv-файле разделитель
+     * @param[in] buffer_size размер буфера чтения в байтах
+     */
+    explicit EntryReader(const std::string& filename, char sep=',', std::size_t buffer_size=1 << 16);
+
+    EntryReader(const EntryReader&) = delete;
+    EntryReader& operator=(const EntryReader&) = delete;
+
+    /**
+     * @brief Читает следующую запись
+     * @return указатель на запись, действительный до следующего вызова; nullptr в конце файла
+     */
+    const Entry* next();
+
+    /**
+     * @brief Читает до max_count записей подряд
+     * @param[out] batch вектор, который очищается и заполняется записями
+     * @param[in] max_count наибольшее число записей
+     * @return число прочитанных записей; 0 в конце файла
+     */
+    std::size_t read_batch(std::vector<Entry>& batch, std::size_t max_count);
+
+    /**
+     * @brief Итератор на текущую запись; begin() можно вызвать один раз
+     */
+    iterator begin() { return iterator(this); }
+    iterator end() { return iterator(); }
+
+    /**
+     * @brief Число байт, прочитанных из файла
+     */
+    std::size_t bytes_read() const { return bytes_read_; }
+
+private:
+    /**
+     * @brief Находит в буфере следующую целую строку, при необходимости дочитывая файл
+     * @param[out] first, last границы строки (без '\n')
+     * @return false, если строк больше нет
+     */
+    bool next_line(const char*& first, const char*& last);
+
+    std::ifstream file_;
+    char sep_;
+    std::vector<char> buffer_;
+    std::size_t pos_ = 0;           //Начало непрочитанной части буфера
+    std::size_t end_ = 0;           //Конец данных в буфере
+    bool eof_ = false;
+    std::size_t bytes_read_ = 0;
+    std::optional<Entry> entry_;
+};
@@ -0,0 +1,253 @@
+/*
+ * @file
+ * Содержит реализацию хэш-таблицы с открытой адресацией (Robin Hood hashing)
+ */
+
+#pragma once
+
+#include "hash_table.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <vector>
+#include <utility>
+
+
+namespace study
+{
+
+/**
+ * @brief Хэш-таблица с открытой адресацией и линейным пробированием по схеме Robin Hood.
+ * @details Все ячейки лежат в одном непрерывном массиве, поэтому поиск не ходит по указателям
+ * списков корзин. Вместе с ключом в ячейке хранится полный хэш: ключи сравниваются
+ * только при совпадении хэшей. Удаление выполняется обратным сдвигом (backward-shift),
+ * без "надгробий". Интерфейс emplace/equal_range совпадает с study::HashTable.
+ * @tparam Hash функтор хэширования ключа, как у study::HashTable
+ */
+template <typename Key, typename T, typename Hash = std::hash<Key>>
+class FlatHashTable
+{
+public:
+    using hash_function = Hash;
+
+    explicit FlatHashTable(hash_function f = hash_function())
+        : hasher_(std::move(f)),
+          slots_(std::vector<Slot>(16)),
+          shift_(60)
+    {}
+
+    static inline std::list<T> empty_list{};
+
+    /**
+     * @brief Ищет в таблице все элементы, соответствующие ключу
+     * @details Как и у study::HashTable, при прозрачной хэш-функции ключ может быть
+     * любого сравнимого с Key типа, например std::string_view.
+     * @param[in] key ключ, по которому осуществляется поиск
+     * @return std::list из значений типа T, которые хранятся по ключу key
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    const std::list<T>& equal_range(const K& key) const
+    {
+        const std::size_t pos = find_slot(key, hasher_(key));
+        return pos == npos ? empty_list : slots_[pos].values;
+    }
+
+    /**
+     * @brief Ищет в таблице значения, соответствующие ключу
+     * @param[in] key ключ, по которому осуществляется поиск
+     * @return указатель на список значений или nullptr, если ключа нет в таблице
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    const std::list<T>* find(const K& key) const
+    {
+        const std::size_t pos = find_slot(key, hasher_(key));
+        return pos == npos ? nullptr : &slots_[pos].values;
+    }
+
+    /**
+     * @brief Проверяет, есть ли ключ в таблице
+     * @param[in] key
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    bool contains(const K& key) const
+    {
+        return find_slot(key, hasher_(key)) != npos;
+    }
+
+    /**
+     * @brief Вставляет элемент с ключом и значением в хэш-таблицу
+     * @param[in] key
+     * @param[in] value
+     */
+    void emplace(const Key& key, T value)
+    {
+        std::list<T> values {value};
+        emplace(key, std::move(values));
+    }
+
+    /**
+     * @brief Вставляет элемент с ключом и списком его значений в хэш-таблицу
+     * @param[in] key
+     * @param[in] values
+     */
+    void emplace(const Key& key, std::list<T> values)
+    {
+        const std::size_t hash = hasher_(key);
+        const std::size_t pos = find_slot(key, hash);
+        if (pos != npos)
+        {
+            for (T& value : values)
+                slots_[pos].values.emplace_front(std::move(value));
+            return;
+        }
+
+        if ((size_ + 1) * 8 > slots_.size() * 7)
+            grow();
+        insert_new(Slot(hash, key, std::move(values)));
+    }
+
+    /**
+     * @brief Удаляет из таблицы ключ вместе со всеми его значениями
+     * @param[in] key
+     * @return true, если ключ был найден и удален
+     */
+    bool erase(const Key& key)
+    {
+        std::size_t pos = find_slot(key, hasher_(key));
+        if (pos == npos)
+            return false;
+
+        // Обратный сдвиг: следующие за удаленной ячейки с ненулевым смещением
+        // сдвигаются на одну позицию назад, пока не встретится пустая ячейка
+        // или ячейка, стоящая на своем "родном" месте
+        std::size_t next = (pos + 1) & mask();
+        while (slots_[next].dist > 1)
+        {
+            slots_[pos] = std::move(slots_[next]);
+            --slots_[pos].dist;
+            pos = next;
+            next = (next + 1) & mask();
+        }
+        slots_[pos] = Slot();
+        --size_;
+        return true;
+    }
+
+    /**
+     * @brief Увеличивает массив ячеек так, чтобы count ключей поместились без роста таблицы
+     * @param[in] count ожидаемое число различных ключей
+     */
+    void reserve(std::size_t count)
+    {
+        while (count * 8 > slots_.size() * 7)
+            grow();
+    }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return slots_.size(); }
+
+private:
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Ячейка таблицы. dist == 0 означает пустую ячейку,
+     * иначе dist - 1 -- расстояние от "родной" позиции ключа.
+     */
+    struct Slot
+    {
+        Slot() = default;
+        Slot(std::size_t h, Key k, std::list<T> v)
+            : hash(h)
+            , key(std::move(k))
+            , values(std::move(v))
+            , dist(1)
+        {}
+
+        std::size_t hash = 0;
+        Key key{};
+        std::list<T> values;
+        std::uint32_t dist = 0;
+    };
+
+    std::size_t mask() const { return slots_.size() - 1; }
+
+    /**
+     * @brief Вычисляет "родную" позицию ключа по его хэшу
+     * @details Хэш перемешивается умножением Фибоначчи: у слабых хэш-функций
+     * (например, simple_hash) младшие биты распределены плохо, а размер таблицы --
+     * степень двойки.
+     */
+    std::size_t home(std::size_t hash) const
+    {
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> shift_);
+    }
+
+    /**
+     * @brief Ищет ячейку с ключом
+     * @param[in] key
+     * @param[in] hash хэш ключа
+     * @return индекс ячейки или npos, если ключа нет в таблице
+     */
+    template <typename K>
+    std::size_t find_slot(const K& key, std::size_t hash) const
+    {
+        std::size_t pos = home(hash);
+        for (std::uint32_t dist = 1; ; ++dist)
+        {
+            const Slot& slot = slots_[pos];
+            // Robin Hood: если у ячейки смещение меньше нашего, ключа дальше быть не может
+            if (slot.dist < dist)
+                return npos;
+            if (slot.hash == hash && slot.key == key)
+                return pos;
+            pos = (pos + 1) & mask();
+        }
+    }
+
+    /**
+     * @brief Вставляет ячейку с ключом, которого точно нет в таблице
+     * @param[in] slot
+     */
+    void insert_new(Slot slot)
+    {
+        std::size_t pos = home(slot.hash);
+        while (slots_[pos].dist != 0)
+        {
+            // Забираем место у "богатой" ячейки, стоящей ближе к своей позиции
+            if (slots_[pos].dist < slot.dist)
+                std::swap(slots_[pos], slot);
+            pos = (pos + 1) & mask();
+            ++slot.dist;
+        }
+        slots_[pos] = std::move(slot);
+        ++size_;
+    }
+
+    /**
+     * @brief Увеличивает массив ячеек вдвое и заново раскладывает ключи
+     */
+    void grow()
+    {
+        std::vector<Slot> old_slots(slots_.size() * 2);
+        std::swap(slots_, old_slots);
+        --shift_;
+        size_ = 0;
+
+        for (Slot& slot : old_slots)
+        {
+            if (slot.dist == 0)
+                continue;
+            slot.dist = 1;
+            insert_new(std::move(slot));
+        }
+    }
+
+    hash_function hasher_;
+    std::vector<Slot> slots_;
+    std::size_t size_ = 0;
+    unsigned shift_;        //64 - log2(slots_.size())
+};
+
+} //namespace study
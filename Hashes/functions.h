@@ -1,6 +1,7 @@
 #pragma once
 
 #include "entry.h"
+#include "entry_io.h"
 #include <fstream>
 #include <string>
 #include <vector>
@@ -0,0 +1,127 @@
+/**
+ * @file
+ * Содержит оценки качества хэш-функций: равномерность по корзинам и лавинный эффект
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace study
+{
+
+/**
+ * @brief Заполненность корзин таблицы из table_size корзин, если ключ с хэшем h
+ * попадает в корзину h % table_size (как в study::HashTable)
+ * @param[in] hashes хэши ключей
+ * @param[in] table_size число корзин
+ * @return число ключей в каждой корзине
+ */
+inline std::vector<std::size_t> bucket_occupancy(const std::vector<std::size_t>& hashes, std::size_t table_size)
+{
+    std::vector<std::size_t> counts(table_size, 0);
+    for (std::size_t hash : hashes)
+        ++counts[hash % table_size];
+    return counts;
+}
+
+/**
+ * @brief Статистика хи-квадрат заполненности корзин, деленная на число степеней свободы
+ * @details Для равномерной хэш-функции значение близко к 1; чем оно больше, тем
+ * сильнее ключи скапливаются в части корзин.
+ * @param[in] counts число ключей в каждой корзине (см. bucket_occupancy)
+ */
+inline double chi_squared(const std::vector<std::size_t>& counts)
+{
+    if (counts.size() < 2)
+        return 0;
+    std::size_t total = 0;
+    for (std::size_t count : counts)
+        total += count;
+    const double expected = static_cast<double>(total) / static_cast<double>(counts.size());
+    if (expected == 0)
+        return 0;
+
+    double chi2 = 0;
+    for (std::size_t count : counts)
+    {
+        const double diff = static_cast<double>(count) - expected;
+        chi2 += diff * diff / expected;
+    }
+    return chi2 / static_cast<double>(counts.size() - 1);
+}
+
+/**
+ * @brief Длина самой длинной цепочки
+ * @param[in] counts число ключей в каждой корзине (см. bucket_occupancy)
+ */
+inline std::size_t longest_chain(const std::vector<std::size_t>& counts)
+{
+    return counts.empty() ? 0 : *std::max_element(counts.begin(), counts.end());
+}
+
+/**
+ * @brief Смещение лавинного эффекта для каждого входного бита
+ * @details Для каждого ключа и каждого из первых input_bits бит ключа бит инвертируется,
+ * и считается, как часто меняется каждый из 64 бит хэша. У идеальной функции любой
+ * бит хэша меняется с вероятностью 1/2. Смещение входного бита -- среднее по битам
+ * хэша значение |2p - 1|: 0 -- идеально, 1 -- бит хэша либо не меняется никогда,
+ * либо меняется всегда. Ключи короче бита не учитываются для него; если ни один
+ * ключ не содержит бита, его смещение -- NaN (бит не измерен).
+ * @param[in] hasher хэш-функция, принимающая std::string_view
+ * @param[in] keys ключи
+ * @param[in] input_bits число проверяемых бит от начала ключа
+ * @return вектор смещений длины input_bits
+ */
+template <typename Hasher>
+std::vector<double> avalanche_bias(const Hasher& hasher, const std::vector<std::string>& keys,
+                                   std::size_t input_bits = 128)
+{
+    constexpr std::size_t output_bits = 64;
+    std::vector<std::vector<std::size_t>> flips(input_bits, std::vector<std::size_t>(output_bits, 0));
+    std::vector<std::size_t> samples(input_bits, 0);
+    std::string flipped;
+
+    for (const std::string& key : keys)
+    {
+        const std::uint64_t hash = static_cast<std::uint64_t>(hasher(std::string_view(key)));
+        flipped = key;
+        const std::size_t bits = std::min(input_bits, key.size() * 8);
+        for (std::size_t bit = 0; bit < bits; ++bit)
+        {
+            const char mask = static_cast<char>(1u << (bit % 8));
+            flipped[bit / 8] ^= mask;
+            const std::bitset<output_bits> diff(hash ^ static_cast<std::uint64_t>(hasher(std::string_view(flipped))));
+            flipped[bit / 8] ^= mask;
+
+            ++samples[bit];
+            for (std::size_t out = 0; out < output_bits; ++out)
+                flips[bit][out] += diff[out];
+        }
+    }
+
+    std::vector<double> bias(input_bits, std::numeric_limits<double>::quiet_NaN());
+    for (std::size_t bit = 0; bit < input_bits; ++bit)
+    {
+        if (samples[bit] == 0)
+            continue;
+        double sum = 0;
+        for (std::size_t out = 0; out < output_bits; ++out)
+        {
+            const double p = static_cast<double>(flips[bit][out]) / static_cast<double>(samples[bit]);
+            sum += p > 0.5 ? 2 * p - 1 : 1 - 2 * p;
+        }
+        bias[bit] = sum / output_bits;
+    }
+    return bias;
+}
+
+} //namespace study
@@ -0,0 +1,361 @@
+/**
+ * @file
+ * Содержит снимок хэш-таблицы записей Entry в файле, который отображается в память
+ */
+
+#pragma once
+
+#include "entry.h"
+#include "hash_table.h"
+#include "mapped_file.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace study
+{
+
+/**
+ * @brief Запись Entry, прочитанная из снимка: строки указывают прямо в отображенный файл
+ */
+struct SnapshotEntry
+{
+    std::string_view name;
+    Entry::Age age;
+    Entry::Height height;
+    Entry::Weight weight;
+    std::string_view sport;
+
+    Entry to_entry() const
+    {
+        return Entry(Entry::Name(name), age, height, weight, Entry::Sport(sport));
+    }
+};
+
+namespace snapshot_format
+{
+/**
+ * @brief Формат файла снимка
+ * @details Все ссылки внутри файла -- смещения от его начала, поэтому файл можно
+ * отобразить по любому адресу. Файл состоит из заголовка, массива начал корзин
+ * (bucket_count + 1 чисел, как в сжатом разреженном формате), массива ключей,
+ * отсортированного по корзинам, массива записей, отсортированного по ключам,
+ * и пула строк. Числа записаны в порядке байтов платформы, на которой создан снимок.
+ */
+constexpr char magic[8] = {'S', 'T', 'H', 'S', 'N', 'A', 'P', '1'};
+
+struct Header
+{
+    char magic[8];
+    std::uint32_t key_count;
+    std::uint32_t entry_count;
+    std::uint32_t bucket_shift;     //64 - log2(числа корзин)
+    std::uint32_t bucket_count;
+    std::uint32_t buckets_offset;
+    std::uint32_t keys_offset;
+    std::uint32_t entries_offset;
+    std::uint32_t strings_offset;
+    std::uint64_t file_size;
+};
+
+struct KeyRecord
+{
+    std::uint64_t hash;
+    std::uint32_t name_offset;
+    std::uint32_t name_length;
+    std::uint32_t first_entry;
+    std::uint32_t entry_count;
+};
+
+struct EntryRecord
+{
+    std::uint32_t name_offset;
+    std::uint32_t name_length;
+    std::int32_t age;
+    std::int32_t height;
+    std::int32_t weight;
+    std::uint32_t sport_offset;
+    std::uint32_t sport_length;
+};
+} // namespace snapshot_format
+
+/**
+ * @brief Хэш-таблица записей Entry, отображенная из файла снимка.
+ * @details Снимок создается функцией write() из готовой study::HashTable и
+ * открывается конструктором: файл отображается в память и проверяется заголовок,
+ * после чего поиск идет прямо по отображенным данным -- без разбора текста и без
+ * выделения памяти. Хэш-функция при чтении должна совпадать с той, с которой
+ * снимок был записан.
+ * @tparam Hash функтор хэширования, принимающий std::string_view (см. hashes.h)
+ */
+template <typename Hash>
+class HashSnapshot
+{
+public:
+    /**
+     * @brief Диапазон записей, найденных по ключу
+     */
+    class Range
+    {
+    public:
+        Range() = default;
+        Range(const HashSnapshot* snapshot, const snapshot_format::EntryRecord* first, std::size_t count)
+            : snapshot_(snapshot), first_(first), count_(count)
+        {}
+
+        std::size_t size() const { return count_; }
+        bool empty() const { return count_ == 0; }
+        SnapshotEntry operator[](std::size_t i) const { return snapshot_->entry(first_[i]); }
+
+    private:
+        const HashSnapshot* snapshot_ = nullptr;
+        const snapshot_format::EntryRecord* first_ = nullptr;
+        std::size_t count_ = 0;
+    };
+
+    /**
+     * @brief Открывает снимок
+     * @param[in] filename имя файла, созданного write()
+     * @param[in] f хэш-функция, с которой снимок был записан
+     * @throw std::runtime_error, если файл не открывается или не является снимком
+     */
+    explicit HashSnapshot(const std::string& filename, Hash f = Hash())
+        : file_(filename),
+          hasher_(std::move(f))
+    {
+        using namespace snapshot_format;
+        if (file_.size() < sizeof(Header))
+            throw std::runtime_error("Snapshot file is too small");
+        std::memcpy(&header_, file_.data(), sizeof(Header));
+        if (std::memcmp(header_.magic, magic, sizeof(magic)) != 0 || header_.file_size != file_.size()
+                || header_.buckets_offset < sizeof(Header)
+                || header_.buckets_offset + (std::uint64_t(header_.bucket_count) + 1) * sizeof(std::uint32_t)
+                       > header_.keys_offset
+                || header_.keys_offset + std::uint64_t(header_.key_count) * sizeof(KeyRecord) > header_.entries_offset
+                || header_.entries_offset + std::uint64_t(header_.entry_count) * sizeof(EntryRecord)
+                       > header_.strings_offset
+                || header_.strings_offset > header_.file_size)
+            throw std::runtime_error("Invalid snapshot file");
+        if (header_.buckets_offset % alignof(std::uint32_t) != 0 || header_.keys_offset % alignof(KeyRecord) != 0
+                || header_.entries_offset % alignof(EntryRecord) != 0)
+            throw std::runtime_error("Invalid snapshot file: misaligned sections");
+        // Число корзин -- степень двойки, согласованная со сдвигом (bucket_count хранится в 32 битах)
+        if (header_.bucket_shift < 33 || header_.bucket_shift > 64
+                || header_.bucket_count != std::uint64_t(1) << (64 - header_.bucket_shift))
+            throw std::runtime_error("Invalid snapshot file: bucket count does not match bucket shift");
+
+        buckets_ = reinterpret_cast<const std::uint32_t*>(file_.data() + header_.buckets_offset);
+        keys_ = reinterpret_cast<const KeyRecord*>(file_.data() + header_.keys_offset);
+        entries_ = reinterpret_cast<const EntryRecord*>(file_.data() + header_.entries_offset);
+        strings_ = file_.data() + header_.strings_offset;
+        validate();
+    }
+
+    /**
+     * @brief Ищет в снимке все записи, соответствующие ключу
+     * @param[in] key ключ, по которому осуществляется поиск
+     * @return диапазон записей; пустой, если ключа нет
+     */
+    Range equal_range(std::string_view key) const
+    {
+        const std::uint64_t hash = hasher_(key);
+        const std::size_t bucket = bucket_index(hash, header_.bucket_shift);
+        for (std::uint32_t i = buckets_[bucket]; i != buckets_[bucket + 1]; ++i)
+        {
+            const snapshot_format::KeyRecord& record = keys_[i];
+            if (record.hash == hash && string(record.name_offset, record.name_length) == key)
+                return Range(this, entries_ + record.first_entry, record.entry_count);
+        }
+        return Range();
+    }
+
+    /**
+     * @brief Проверяет, есть ли ключ в снимке
+     * @param[in] key
+     */
+    bool contains(std::string_view key) const { return !equal_range(key).empty(); }
+
+    std::size_t size() const { return header_.key_count; }
+
+    /**
+     * @brief Записывает снимок хэш-таблицы в файл
+     * @param[in] filename имя файла
+     * @param[in] table таблица, ключ которой -- имя записи
+     * @param[in] f хэш-функция снимка; чтобы поиск по нему шел по тем же корзинам,
+     * ее нужно передать и в конструктор
+     * @throw std::runtime_error, если файл не удалось записать или он больше 4 ГБ
+     */
+    template <typename TableHash, typename Allocator>
+    static void write(const std::string& filename, const HashTable<Entry::Name, Entry, TableHash, Allocator>& table,
+                      Hash f = Hash())
+    {
+        using namespace snapshot_format;
+        using value_list = typename HashTable<Entry::Name, Entry, TableHash, Allocator>::value_list;
+
+        std::uint32_t bucket_shift = 64;
+        while ((std::uint64_t(1) << (64 - bucket_shift)) < table.size())
+            --bucket_shift;
+        const std::size_t bucket_count = std::size_t(1) << (64 - bucket_shift);
+
+        // Ключи со значениями собираются в порядке обхода, затем сортировкой
+        // подсчетом группируются по корзинам снимка
+        std::vector<std::pair<const Entry::Name*, const value_list*>> items;
+        std::vector<std::uint64_t> hashes;
+        std::vector<std::uint32_t> buckets(bucket_count + 1, 0);
+        items.reserve(table.size());
+        hashes.reserve(table.size());
+        table.for_each([&](const Entry::Name& key, const value_list& values)
+        {
+            items.emplace_back(&key, &values);
+            hashes.push_back(f(key));
+            ++buckets[bucket_index(hashes.back(), bucket_shift) + 1];
+        });
+        for (std::size_t i = 1; i < buckets.size(); ++i)
+            buckets[i] += buckets[i - 1];
+
+        std::vector<std::size_t> order(items.size());
+        std::vector<std::uint32_t> next(buckets.begin(), buckets.end() - 1);
+        for (std::size_t i = 0; i < items.size(); ++i)
+            order[next[bucket_index(hashes[i], bucket_shift)]++] = i;
+
+        std::string strings;
+        auto add_string = [&strings](std::string_view str)
+        {
+            const std::size_t offset = strings.size();
+            strings.append(str);
+            return std::make_pair(checked(offset), checked(str.size()));
+        };
+
+        std::vector<KeyRecord> keys;
+        std::vector<EntryRecord> entries;
+        keys.reserve(items.size());
+        for (std::size_t i : order)
+        {
+            const auto [name_offset, name_length] = add_string(*items[i].first);
+            keys.push_back({hashes[i], name_offset, name_length, checked(entries.size()),
+                            checked(items[i].second->size())});
+            for (const Entry& entry : *items[i].second)
+            {
+                const auto [sport_offset, sport_length] = add_string(entry.getSport());
+                entries.push_back({name_offset, name_length, entry.getAge(), entry.getHeight(), entry.getWeight(),
+                                   sport_offset, sport_length});
+            }
+        }
+
+        Header header{};
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.key_count = checked(keys.size());
+        header.entry_count = checked(entries.size());
+        header.bucket_shift = bucket_shift;
+        header.bucket_count = checked(bucket_count);
+        header.buckets_offset = sizeof(Header);
+        header.keys_offset = checked(align8(header.buckets_offset + buckets.size() * sizeof(std::uint32_t)));
+        header.entries_offset = checked(header.keys_offset + keys.size() * sizeof(KeyRecord));
+        header.strings_offset = checked(header.entries_offset + entries.size() * sizeof(EntryRecord));
+        header.file_size = header.strings_offset + strings.size();
+        checked(header.file_size);
+
+        std::ofstream out(filename, std::ios::binary);
+        if (!out.is_open())
+            throw std::runtime_error("Cannot open output snapshot file");
+        const std::vector<char> padding(header.keys_offset - header.buckets_offset
+                                        - buckets.size() * sizeof(std::uint32_t), 0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(buckets.data()),
+                  static_cast<std::streamsize>(buckets.size() * sizeof(std::uint32_t)));
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        out.write(reinterpret_cast<const char*>(keys.data()),
+                  static_cast<std::streamsize>(keys.size() * sizeof(KeyRecord)));
+        out.write(reinterpret_cast<const char*>(entries.data()),
+                  static_cast<std::streamsize>(entries.size() * sizeof(EntryRecord)));
+        out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+        if (!out)
+            throw std::runtime_error("Cannot write snapshot file");
+    }
+
+private:
+
+    /**
+     * @brief Номер корзины снимка: старшие биты хэша, перемешанного умножением Фибоначчи
+     */
+    static std::size_t bucket_index(std::uint64_t hash, std::uint32_t shift)
+    {
+        if (shift == 64)
+            return 0;
+        return static_cast<std::size_t>((hash * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    static std::uint32_t checked(std::uint64_t value)
+    {
+        if (value > UINT32_MAX)
+            throw std::runtime_error("Snapshot is larger than 4 GB");
+        return static_cast<std::uint32_t>(value);
+    }
+
+    static std::uint64_t align8(std::uint64_t value) { return (value + 7) & ~std::uint64_t(7); }
+
+    std::string_view string(std::uint32_t offset, std::uint32_t length) const
+    {
+        return std::string_view(strings_ + offset, length);
+    }
+
+    /**
+     * @brief Проверяет ссылки внутри снимка, чтобы поиск никогда не вышел за границы файла
+     * @details Начала корзин не убывают и заканчиваются числом ключей, диапазоны записей
+     * ключей лежат в массиве записей, строки -- в пуле строк.
+     * @throw std::runtime_error, если какая-то ссылка неверна
+     */
+    void validate() const
+    {
+        using namespace snapshot_format;
+        const std::uint64_t strings_size = header_.file_size - header_.strings_offset;
+        auto in_pool = [strings_size](std::uint32_t offset, std::uint32_t length)
+        {
+            return std::uint64_t(offset) + length <= strings_size;
+        };
+
+        if (buckets_[0] != 0 || buckets_[header_.bucket_count] != header_.key_count)
+            throw std::runtime_error("Invalid snapshot file: wrong bucket bounds");
+        for (std::uint32_t i = 0; i < header_.bucket_count; ++i)
+            if (buckets_[i] > buckets_[i + 1])
+                throw std::runtime_error("Invalid snapshot file: bucket starts are not monotone");
+
+        for (std::uint32_t i = 0; i < header_.key_count; ++i)
+        {
+            const KeyRecord& key = keys_[i];
+            if (std::uint64_t(key.first_entry) + key.entry_count > header_.entry_count)
+                throw std::runtime_error("Invalid snapshot file: key entries out of range");
+            if (!in_pool(key.name_offset, key.name_length))
+                throw std::runtime_error("Invalid snapshot file: key name out of range");
+        }
+        for (std::uint32_t i = 0; i < header_.entry_count; ++i)
+        {
+            const EntryRecord& record = entries_[i];
+            if (!in_pool(record.name_offset, record.name_length) || !in_pool(record.sport_offset, record.sport_length))
+                throw std::runtime_error("Invalid snapshot file: entry string out of range");
+        }
+    }
+
+    SnapshotEntry entry(const snapshot_format::EntryRecord& record) const
+    {
+        return {string(record.name_offset, record.name_length), record.age, record.height, record.weight,
+                string(record.sport_offset, record.sport_length)};
+    }
+
+    MappedFile file_;
+    Hash hasher_;
+    snapshot_format::Header header_;
+    const std::uint32_t* buckets_ = nullptr;
+    const snapshot_format::KeyRecord* keys_ = nullptr;
+    const snapshot_format::EntryRecord* entries_ = nullptr;
+    const char* strings_ = nullptr;
+};
+
+} //namespace study
@@ -5,9 +5,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <iterator>
 #include <list>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 #include <utility>
 
@@ -15,38 +23,223 @@
 namespace study
 {
 
-template <typename Key, typename T>
+/**
+ * @brief Хэш-функция со стертым типом для выбора функции во время выполнения.
+ * @details Вызов идет косвенно через std::function, поэтому встроить хэш-функцию
+ * в поиск компилятор не может. Для быстрого поиска тип хэш-функции
+ * передается параметром шаблона (см. функторы из hashes.h).
+ */
+template <typename Key>
+using erased_hash = std::function<std::size_t(const Key&)>;
+
+/**
+ * @brief Проверяет, объявлен ли у хэш-функции тип is_transparent, то есть
+ * умеет ли она хэшировать ключи других типов (например, std::string_view) так же, как Key
+ */
+template <typename Hash, typename = void>
+struct is_transparent_hash : std::false_type {};
+
+template <typename Hash>
+struct is_transparent_hash<Hash, std::void_t<typename Hash::is_transparent>> : std::true_type {};
+
+/**
+ * @brief Тип K подходит для поиска в таблице с ключом Key и хэш-функцией Hash:
+ * либо хэш-функция прозрачная, либо K приводится к Key
+ */
+template <typename K, typename Key, typename Hash>
+using enable_if_lookup_key = std::enable_if_t<is_transparent_hash<Hash>::value ||
+                                              std::is_convertible_v<const K&, const Key&>>;
+
+/**
+ * @brief Способ перехэширования хэш-таблицы
+ */
+enum class RehashMode
+{
+    full,           ///< вся таблица перестраивается за одну вставку
+    incremental     ///< корзины переносятся в новую таблицу по несколько штук при вставках и поисках
+};
+
+/**
+ * @brief Проверяет, есть ли у хэш-функции зерно -- поле seed (см. WyHash и MurmurHash из hashes.h)
+ */
+template <typename Hash, typename = void>
+struct is_seeded_hash : std::false_type {};
+
+template <typename Hash>
+struct is_seeded_hash<Hash, std::void_t<decltype(std::declval<Hash&>().seed = std::uint64_t())>> : std::true_type {};
+
+/**
+ * @brief Выбор зерна хэш-функции хэш-таблицей
+ */
+enum class SeedMode
+{
+    fixed,          ///< зерно, с которым передана хэш-функция
+    random          ///< случайное зерно при создании и новое при патологическом росте цепочек
+};
+
+/**
+ * @brief Статистика внутреннего устройства хэш-таблицы, см. HashTable::stats()
+ */
+struct HashTableStats
+{
+    std::size_t size = 0;                   ///< число различных ключей
+    std::size_t bucket_count = 0;           ///< число корзин
+    double load_factor = 0;                 ///< ключей на корзину
+    std::vector<std::size_t> chain_lengths; ///< гистограмма: chain_lengths[i] -- число корзин из i элементов
+    std::size_t empty_buckets = 0;          ///< число пустых корзин
+    std::size_t bucket_size = 0;            ///< текущее ограничение на размер корзины
+    std::size_t rehash_count = 0;           ///< число перехэширований (включая рост только bucket_size)
+    std::size_t reseed_count = 0;           ///< число смен зерна хэш-функции (SeedMode::random)
+    std::uint64_t rehash_time = 0;          ///< суммарное время перехэширований, нс
+    double average_probes = 0;              ///< среднее число сравнений ключей на один поиск (только при track_lookups(true))
+};
+
+/**
+ * @brief Хэш-таблица с цепочками
+ * @tparam Key тип ключа
+ * @tparam T тип значения
+ * @tparam Hash функтор хэширования ключа; erased_hash<Key> -- для выбора хэш-функции во время выполнения
+ * @tparam Allocator аллокатор для узлов корзин, списков значений и массива корзин.
+ * Корзины массива создаются без явной передачи аллокатора, поэтому он должен быть либо
+ * без состояния, либо "scoped", как std::pmr::polymorphic_allocator (см. pool_allocator.h).
+ */
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename Allocator = std::allocator<T>>
 class HashTable
 {
+    template <typename U>
+    using rebind_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
 public:
-    using hash_function = std::function<std::size_t(const Key)>;
+    using hash_function = Hash;
+    using allocator_type = Allocator;
+    using value_list = std::list<T, rebind_alloc<T>>;
 
-    HashTable(hash_function f)
+    explicit HashTable(hash_function f = hash_function(), RehashMode mode = RehashMode::full,
+                       const allocator_type& alloc = allocator_type())
         : hasher_(std::move(f)),
-          table_(std::vector<Bucket>(11))
+          table_(11, alloc),
+          mode_(mode),
+          next_table_(alloc),
+          old_table_(alloc)
     {}
 
+    /**
+     * @param[in] f хэш-функция
+     * @param[in] mode способ перехэширования
+     * @param[in] seeding при SeedMode::random таблица выбирает хэш-функции случайное зерно,
+     * а когда цепочка переполняется при почти пустой таблице (обычно это подобранные
+     * или просто неудачные ключи), меняет зерно и раскладывает ключи заново вместо
+     * увеличения bucket_size. Подряд зерно меняется не больше max_reseeds раз,
+     * дальше растет bucket_size, как при SeedMode::fixed.
+     * @param[in] alloc аллокатор
+     * @throw std::invalid_argument при SeedMode::random, если у хэш-функции нет зерна
+     */
+    HashTable(hash_function f, RehashMode mode, SeedMode seeding, const allocator_type& alloc = allocator_type())
+        : HashTable(std::move(f), mode, alloc)
+    {
+        seeding_ = seeding;
+        if (seeding_ == SeedMode::random)
+        {
+            if constexpr (is_seeded_hash<Hash>::value)
+                hasher_.seed = random_seed();
+            else
+                throw std::invalid_argument("HashTable: SeedMode::random needs a hash function with a seed");
+        }
+    }
+
     HashTable(const HashTable&) = default;
     HashTable& operator=(const HashTable&) = default;
     HashTable(HashTable&&) noexcept = default;
     HashTable& operator=(HashTable&&) noexcept = default;
 
-    static inline std::list<T> empty_list{};
+    static inline value_list empty_list{};
 
     /**
      * @brief Ищет в таблице все элементы, соответствующие ключу
+     * @details При прозрачной хэш-функции ключ может быть любого типа, который она
+     * принимает и который сравнивается с Key (например, std::string_view для std::string):
+     * тогда поиск не создает временный Key.
      * @param[in] key ключ, по которому осуществляется поиск
      * @return std::list из значений типа T, которые хранятся по ключу key
      */
-    const std::list<T>& equal_range(const Key& key) const
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    const value_list& equal_range(const K& key) const
     {
-        const Bucket& cur_bucket = table_[index(key)];
+        const InBucket* elem = lookup(key);
+        return elem ? elem->values() : empty_list;
+    }
 
-        for (InBucket elem : cur_bucket)
-            if (elem.key() == key)
-                return elem.values();
+    /**
+     * @brief Ищет в таблице все элементы, соответствующие ключу
+     * @details В режиме RehashMode::incremental заодно переносит несколько корзин
+     * из старой таблицы в новую.
+     * @param[in] key ключ, по которому осуществляется поиск
+     * @return std::list из значений типа T, которые хранятся по ключу key
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    const value_list& equal_range(const K& key)
+    {
+        migrate_step();
+        return std::as_const(*this).equal_range(key);
+    }
 
-        return empty_list;
+    /**
+     * @brief Ищет в таблице значения, соответствующие ключу
+     * @param[in] key ключ, по которому осуществляется поиск
+     * @return указатель на список значений или nullptr, если ключа нет в таблице
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    const value_list* find(const K& key) const
+    {
+        const InBucket* elem = lookup(key);
+        return elem ? &elem->values() : nullptr;
+    }
+
+    /**
+     * @brief Проверяет, есть ли ключ в таблице
+     * @param[in] key
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    bool contains(const K& key) const
+    {
+        return lookup(key) != nullptr;
+    }
+
+    /**
+     * @brief Хэш ключа той функцией, по которой таблица раскладывает ключи
+     * @details Посчитанный хэш можно передать в find, contains и emplace, чтобы не
+     * хэшировать ключ повторно (см. study::ConcurrentHashTable). При SeedMode::random
+     * зерно меняется при вставке, поэтому хэш действителен только до изменения таблицы.
+     * @param[in] key
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    std::size_t hash_code(const K& key) const
+    {
+        return static_cast<std::size_t>(hasher_(key));
+    }
+
+    /**
+     * @brief Ищет в таблице значения, соответствующие ключу с уже посчитанным хэшем
+     * @param[in] key ключ, по которому осуществляется поиск
+     * @param[in] hash хэш ключа, равный hash_code(key)
+     * @return указатель на список значений или nullptr, если ключа нет в таблице
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    const value_list* find(const K& key, std::size_t hash) const
+    {
+        const InBucket* elem = lookup(key, hash);
+        return elem ? &elem->values() : nullptr;
+    }
+
+    /**
+     * @brief Проверяет, есть ли в таблице ключ с уже посчитанным хэшем
+     * @param[in] key
+     * @param[in] hash хэш ключа, равный hash_code(key)
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    bool contains(const K& key, std::size_t hash) const
+    {
+        return lookup(key, hash) != nullptr;
     }
 
     /**
@@ -56,8 +249,9 @@ public:
      */
     void emplace(const Key& key, T value)
     {
-        std::list<T> values {value};
-        emplace(key, values);
+        value_list values(get_allocator());
+        values.emplace_back(std::move(value));
+        emplace(key, std::move(values));
     }
 
     /**
@@ -65,9 +259,40 @@ public:
      * @param[in] key
      * @param[in] values
      */
-    void emplace(const Key& key, std::list<T> values)
+    void emplace(const Key& key, value_list values)
     {
-        Bucket& bucket = table_[index(key)];
+        emplace(key, hash_code(key), std::move(values));
+    }
+
+    /**
+     * @brief Вставляет элемент с ключом, его уже посчитанным хэшем и значением в хэш-таблицу
+     * @param[in] key
+     * @param[in] hash хэш ключа, равный hash_code(key)
+     * @param[in] value
+     */
+    void emplace(const Key& key, std::size_t hash, T value)
+    {
+        value_list values(get_allocator());
+        values.emplace_back(std::move(value));
+        emplace(key, hash, std::move(values));
+    }
+
+    /**
+     * @brief Вставляет элемент с ключом, его уже посчитанным хэшем и списком значений в хэш-таблицу
+     * @param[in] key
+     * @param[in] hash хэш ключа, равный hash_code(key)
+     * @param[in] values
+     */
+    void emplace(const Key& key, std::size_t hash, value_list values)
+    {
+        if (mode_ == RehashMode::incremental)
+        {
+            migrate_step();
+            emplace_incremental(key, hash, std::move(values));
+            return;
+        }
+
+        Bucket& bucket = table_[hash % table_.size()];
         for (InBucket& elem : bucket)
         {
             if(elem.key() == key)
@@ -84,14 +309,161 @@ public:
             if (bucket.empty())
                 ++empty_bucket_count;
             bucket.emplace_front(key, std::move(values));
+            ++size_;
         }
         else
         {
+            // rehash() может сменить зерно, поэтому хэш считается заново
             rehash();
             emplace(key, std::move(values));
         }
     }
 
+    /**
+     * @brief Готовит таблицу к хранению count ключей без перехэширования
+     * @details Размер таблицы подбирается с тем же запасом, что дает rehash():
+     * таблица растет, когда занято больше седьмой части корзин. Уже вставленные
+     * элементы переносятся в новые корзины через splice, без перевыделения узлов.
+     * @param[in] count ожидаемое число различных ключей
+     */
+    void reserve(std::size_t count)
+    {
+        while (rehashing())
+            migrate_step();
+
+        std::size_t new_table_size = table_.size();
+        while (new_table_size < count * 7 + 1)
+            new_table_size *= 2;
+        if (new_table_size != table_.size())
+            relink(new_table_size);
+    }
+
+    /**
+     * @brief Заполняет таблицу диапазоном значений
+     * @details Таблица сразу резервируется под весь диапазон (см. reserve()), затем за
+     * один проход считаются индексы корзин, и элементы сортировкой подсчетом
+     * группируются по корзинам. Вставка идет корзина за корзиной с уже
+     * посчитанным хэшем. Если переполнение корзины привело к перехэшированию или
+     * смене зерна, оставшиеся элементы вставляются через emplace.
+     * @param[in] first, last итераторы, указывающие на диапазон значений
+     * @param[in] extractor функция, возвращающая по значению его ключ
+     */
+    template <typename Iterator, typename KeyExtractor>
+    void build(Iterator first, Iterator last, KeyExtractor extractor)
+    {
+        const std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+        reserve(size_ + count);
+
+        std::vector<Iterator> items;
+        std::vector<std::size_t> indices;
+        items.reserve(count);
+        indices.reserve(count);
+        std::vector<std::size_t> bucket_starts(table_.size() + 1, 0);
+        for (Iterator it = first; it != last; ++it)
+        {
+            items.push_back(it);
+            indices.push_back(index(extractor(*it)));
+            ++bucket_starts[indices.back() + 1];
+        }
+        for (std::size_t i = 1; i < bucket_starts.size(); ++i)
+            bucket_starts[i] += bucket_starts[i - 1];
+
+        std::vector<std::size_t> order(count);
+        for (std::size_t i = 0; i < count; ++i)
+            order[bucket_starts[indices[i]]++] = i;
+
+        // Любое перехэширование, в том числе смена зерна без роста таблицы, увеличивает rehash_count_
+        const std::size_t built_epoch = rehash_count_;
+        for (std::size_t i : order)
+        {
+            const Key& key = extractor(*items[i]);
+            if (rehash_count_ != built_epoch || rehashing())
+            {
+                // Таблица уже перехэширована или сменила зерно, посчитанные индексы устарели
+                emplace(key, *items[i]);
+                continue;
+            }
+
+            Bucket& bucket = table_[indices[i]];
+            InBucket* elem = find_in_bucket(bucket, key);
+            if (elem)
+                elem->values().emplace_front(*items[i]);
+            else if (bucket.size() < bucket_size)
+            {
+                if (bucket.empty())
+                    ++empty_bucket_count;
+                value_list values(get_allocator());
+                values.emplace_back(*items[i]);
+                bucket.emplace_front(key, std::move(values));
+                ++size_;
+            }
+            else
+            {
+                // Переполнение корзины: остаток вставляется обычным путем с перехэшированием
+                emplace(key, *items[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Число различных ключей в таблице
+     */
+    std::size_t size() const { return size_; }
+
+    allocator_type get_allocator() const { return allocator_type(table_.get_allocator()); }
+
+    /**
+     * @brief Вызывает f(key, values) для каждого ключа таблицы
+     * @details Порядок обхода -- порядок корзин; во время инкрементального
+     * перехэширования обходятся обе таблицы.
+     * @param[in] f функция, принимающая const Key& и const value_list&
+     */
+    template <typename F>
+    void for_each(F f) const
+    {
+        for (const BucketArray* table : {&table_, &old_table_})
+            for (const Bucket& bucket : *table)
+                for (const InBucket& elem : bucket)
+                    f(elem.key(), elem.values());
+    }
+
+    /**
+     * @brief Собирает статистику по корзинам и счетчикам таблицы
+     * @details Во время инкрементального перехэширования учитываются корзины обеих таблиц.
+     * @return объект HashTableStats
+     */
+    HashTableStats stats() const
+    {
+        HashTableStats result;
+        result.size = size_;
+        result.bucket_count = table_.size() + old_table_.size();
+        result.load_factor = static_cast<double>(size_) / static_cast<double>(result.bucket_count);
+        for (const BucketArray* table : {&table_, &old_table_})
+        {
+            for (const Bucket& bucket : *table)
+            {
+                const std::size_t length = bucket.size();
+                if (result.chain_lengths.size() <= length)
+                    result.chain_lengths.resize(length + 1, 0);
+                ++result.chain_lengths[length];
+            }
+        }
+        result.empty_buckets = result.chain_lengths.empty() ? 0 : result.chain_lengths[0];
+        result.bucket_size = bucket_size;
+        result.rehash_count = rehash_count_;
+        result.reseed_count = reseed_count_;
+        result.rehash_time = rehash_time_;
+        result.average_probes = lookups_ ? static_cast<double>(probes_) / static_cast<double>(lookups_) : 0;
+        return result;
+    }
+
+    /**
+     * @brief Включает или выключает подсчет сравнений ключей при поиске для stats()
+     * @details По умолчанию подсчет выключен. Счетчики меняются в константном поиске,
+     * поэтому с включенным подсчетом таблицу нельзя читать из нескольких потоков одновременно.
+     */
+    void track_lookups(bool enable) { track_lookups_ = enable; }
+
 private:
 
     /**
@@ -100,19 +472,19 @@ private:
     class InBucket
     {
     public:
-        InBucket(Key key, std::list<T> values)
+        InBucket(Key key, value_list values)
             : key_(std::move(key))
             , values_(std::move(values))
         {}
 
         const Key& key() const { return key_; }
         Key& key() { return key_; }
-        const std::list<T>& values() const { return values_ ; }
-        std::list<T>& values() { return values_ ; }
+        const value_list& values() const { return values_ ; }
+        value_list& values() { return values_ ; }
 
     private:
         Key key_;
-        std::list<T> values_;
+        value_list values_;
     };
 
     /**
@@ -120,22 +492,236 @@ private:
      * @param[in] key
      * @return индекс элемента в хэш-таблице
      */
-    std::size_t index(const Key& key) const
+    template <typename K>
+    std::size_t index(const K& key) const
     {
         return hasher_(key) % table_.size();
     }
 
+    /**
+     * @brief Ищет индекс элемента в старой таблице, которая еще не до конца перенесена
+     * @param[in] key
+     * @return индекс элемента в старой таблице
+     */
+    template <typename K>
+    std::size_t old_index(const K& key) const
+    {
+        return hasher_(key) % old_table_.size();
+    }
+
+    /**
+     * @brief Ищет элемент с ключом key в корзине
+     * @param[in] bucket
+     * @param[in] key
+     * @return указатель на элемент или nullptr, если ключа в корзине нет
+     */
+    template <typename B, typename K>
+    static auto find_in_bucket(B& bucket, const K& key, std::size_t* probes = nullptr) -> decltype(&*bucket.begin())
+    {
+        for (auto& elem : bucket)
+        {
+            if (probes)
+                ++*probes;
+            if (elem.key() == key)
+                return &elem;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Ищет элемент с ключом key в таблице, а во время переноса -- и в старой таблице
+     * @param[in] key
+     * @return указатель на элемент или nullptr, если ключа нет в таблице
+     */
+    template <typename K>
+    const InBucket* lookup(const K& key) const
+    {
+        return lookup(key, hash_code(key));
+    }
+
+    /**
+     * @brief То же, что lookup(key), с уже посчитанным хэшем ключа
+     */
+    template <typename K>
+    const InBucket* lookup(const K& key, std::size_t hash) const
+    {
+        // Без подсчета поиск не пишет в память таблицы
+        std::size_t probes = 0;
+        std::size_t* counter = track_lookups_ ? &probes : nullptr;
+        const InBucket* elem = find_in_bucket(table_[hash % table_.size()], key, counter);
+        if (!elem && migrating())
+            elem = find_in_bucket(old_table_[hash % old_table_.size()], key, counter);
+
+        if (counter)
+        {
+            ++lookups_;
+            probes_ += probes;
+        }
+        return elem;
+    }
+
+    bool migrating() const { return !old_table_.empty(); }
+    bool rehashing() const { return preparing_ || migrating(); }
+
+    /**
+     * @brief Вставка в режиме RehashMode::incremental
+     * @details Пока идет перехэширование, корзины могут временно превышать
+     * bucket_size: новое перехэширование не начинается, пока не закончено текущее.
+     */
+    void emplace_incremental(const Key& key, std::size_t hash, value_list values)
+    {
+        InBucket* elem = find_in_bucket(table_[hash % table_.size()], key);
+        if (!elem && migrating())
+            elem = find_in_bucket(old_table_[hash % old_table_.size()], key);
+        if (elem)
+        {
+            for (T& value : values)
+                elem->values().emplace_front(std::move(value));
+            return;
+        }
+
+        if (!rehashing() && table_[hash % table_.size()].size() >= bucket_size)
+        {
+            // start_rehash() может сменить зерно
+            start_rehash();
+            hash = hash_code(key);
+        }
+
+        Bucket& bucket = table_[hash % table_.size()];
+        if (bucket.empty())
+            ++empty_bucket_count;
+        bucket.emplace_front(key, std::move(values));
+        ++size_;
+    }
+
+    /**
+     * @brief Переносит все элементы в новый массив корзин заданного размера
+     * @param[in] new_table_size
+     */
+    void relink(std::size_t new_table_size)
+    {
+        BucketArray old_table(new_table_size, table_.get_allocator());
+        std::swap(table_, old_table);
+        empty_bucket_count = 0;
+
+        for (Bucket& old_bucket : old_table)
+        {
+            while (!old_bucket.empty())
+            {
+                Bucket& new_bucket = table_[index(old_bucket.front().key())];
+                if (new_bucket.empty())
+                    ++empty_bucket_count;
+                new_bucket.splice(new_bucket.begin(), old_bucket, old_bucket.begin());
+            }
+        }
+    }
+
+    /**
+     * @brief Начинает перехэширование в режиме RehashMode::incremental
+     * @details Условие роста то же, что и в rehash(). Если растет только размер
+     * корзины, переносить элементы не нужно. Иначе под новую таблицу только
+     * резервируется память: сами корзины создаются частями в migrate_step(),
+     * так как создание всего массива сразу -- та же задержка, пропорциональная размеру таблицы.
+     */
+    void start_rehash()
+    {
+        if (empty_bucket_count * 7 <= table_.size())
+        {
+            if (can_reseed())
+            {
+                reseed();
+                return;
+            }
+            ++rehash_count_;
+            ++bucket_size;
+            return;
+        }
+
+        ++rehash_count_;
+        reseeds_in_row_ = 0;
+        next_table_size_ = table_.size() * 2;
+        next_table_.reserve(next_table_size_);
+        preparing_ = true;
+    }
+
+    /**
+     * @brief Выполняет ограниченную часть перехэширования
+     * @details Сначала создается не более migrate_buckets корзин новой таблицы, затем,
+     * когда она готова, за шаг переносится не более migrate_buckets корзин из старой таблицы.
+     * Элементы переносятся через splice, без перевыделения узлов, поэтому
+     * ссылки, полученные из equal_range, остаются действительными.
+     */
+    void migrate_step()
+    {
+        // Время шагов суммируется в rehash_time_ для stats()
+        if (!rehashing())
+            return;
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        migrate_step_untimed();
+        rehash_time_ += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                       std::chrono::steady_clock::now() - start).count());
+    }
+
+    void migrate_step_untimed()
+    {
+        if (preparing_)
+        {
+            for (std::size_t made = 0; made < migrate_buckets && next_table_.size() < next_table_size_; ++made)
+                next_table_.emplace_back();
+
+            if (next_table_.size() == next_table_size_)
+            {
+                preparing_ = false;
+                old_table_ = std::exchange(table_, std::move(next_table_));
+                next_table_ = BucketArray(table_.get_allocator());
+                migrated_ = 0;
+                empty_bucket_count = 0;
+            }
+            return;
+        }
+
+        if (!migrating())
+            return;
+
+        for (std::size_t moved = 0; moved < migrate_buckets && migrated_ < old_table_.size(); ++moved, ++migrated_)
+        {
+            Bucket& old_bucket = old_table_[migrated_];
+            while (!old_bucket.empty())
+            {
+                Bucket& new_bucket = table_[index(old_bucket.front().key())];
+                if (new_bucket.empty())
+                    ++empty_bucket_count;
+                new_bucket.splice(new_bucket.begin(), old_bucket, old_bucket.begin());
+            }
+        }
+
+        if (migrated_ == old_table_.size())
+        {
+            old_table_.clear();
+            old_table_.shrink_to_fit();
+        }
+    }
+
     /**
      * @brief Перехэширует таблицу, если было превышено максимальное количество
      * пустых корзин или превышен максимальный размер одной из корзин
      */
     void rehash()
     {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
         std::size_t new_table_size = table_.size();
         std::size_t new_bucket_size = bucket_size;
+        std::size_t reseeds_in_row = reseeds_in_row_;
         if (empty_bucket_count * 7 > table_.size())
         {
             new_table_size = table_.size() * 2;
+            reseeds_in_row = 0;
+        }
+        else if (can_reseed())
+        {
+            reseed();
+            return;
         }
         else
         {
@@ -143,22 +729,84 @@ private:
         }
 
         //Создание новой хэш-таблицы
-        HashTable new_hashtable(hasher_);
+        HashTable new_hashtable(hasher_, mode_, get_allocator());
         new_hashtable.table_.resize(new_table_size);
         new_hashtable.bucket_size = new_bucket_size;
 
         for(Bucket& bucket : table_)
-            for (InBucket elem : bucket)
+            for (InBucket& elem : bucket)
                 new_hashtable.emplace(std::move(elem.key()), std::move(elem.values()));
+
+        // Счетчики переходят в новую таблицу. Время вложенных перехэширований уже
+        // входит во время этого, поэтому оно не суммируется, а заменяется.
+        new_hashtable.rehash_count_ += rehash_count_ + 1;
+        new_hashtable.rehash_time_ = rehash_time_ + static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        new_hashtable.lookups_ = lookups_;
+        new_hashtable.probes_ = probes_;
+        new_hashtable.track_lookups_ = track_lookups_;
+        new_hashtable.seeding_ = seeding_;
+        new_hashtable.reseed_count_ = reseed_count_;
+        new_hashtable.reseeds_in_row_ = reseeds_in_row;
         std::swap(*this, new_hashtable);
     }
 
-    using Bucket = std::list<InBucket>;
+    bool can_reseed() const
+    {
+        return seeding_ == SeedMode::random && reseeds_in_row_ < max_reseeds;
+    }
+
+    /**
+     * @brief Меняет зерно хэш-функции и раскладывает элементы по корзинам заново
+     * @details Размер таблицы не меняется, узлы переносятся через splice.
+     */
+    void reseed()
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if constexpr (is_seeded_hash<Hash>::value)
+            hasher_.seed = random_seed();
+        relink(table_.size());
+        ++rehash_count_;
+        ++reseed_count_;
+        ++reseeds_in_row_;
+        rehash_time_ += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                       std::chrono::steady_clock::now() - start).count());
+    }
+
+    static std::uint64_t random_seed()
+    {
+        thread_local std::mt19937_64 generator(std::random_device{}());
+        return generator();
+    }
+
+    using Bucket = std::list<InBucket, rebind_alloc<InBucket>>;
+    using BucketArray = std::vector<Bucket, rebind_alloc<Bucket>>;
 
     hash_function hasher_;
-    std::vector<Bucket> table_;
+    BucketArray table_;
     std::size_t empty_bucket_count = 0;
     std::size_t bucket_size = 3;    //Для ограничения числа элементов в корзине
+    std::size_t size_ = 0;
+
+    RehashMode mode_;
+    BucketArray next_table_;                //Создаваемая таблица в режиме RehashMode::incremental
+    std::size_t next_table_size_ = 0;
+    bool preparing_ = false;
+    BucketArray old_table_;                 //Переносимая таблица в режиме RehashMode::incremental
+    std::size_t migrated_ = 0;              //Число уже перенесенных корзин old_table_
+    static constexpr std::size_t migrate_buckets = 64;  //Корзин, создаваемых или переносимых за одну операцию
+
+    //Счетчики для stats()
+    std::size_t rehash_count_ = 0;
+    std::uint64_t rehash_time_ = 0;         //нс
+    bool track_lookups_ = false;
+    mutable std::size_t lookups_ = 0;
+    mutable std::size_t probes_ = 0;
+
+    SeedMode seeding_ = SeedMode::fixed;
+    std::size_t reseed_count_ = 0;
+    std::size_t reseeds_in_row_ = 0;        //Смен зерна с последнего роста таблицы
+    static constexpr std::size_t max_reseeds = 3;
 
 
 };
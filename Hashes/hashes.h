@@ -1,36 +1,329 @@
-#include <string>
+/**
+ * @file
+ * Содержит объявления хэш-функций и функторы с их реализацией
+ * @details Все функции принимают std::string_view: std::string приводится к нему
+ * без копирования, а срезы буфера запроса хэшируются без выделения памяти.
+ * Функторы прозрачные (is_transparent), поэтому таблицы с ними ищут по любому
+ * ключу, приводимому к std::string_view.
+ */
+
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
 namespace study
 {
+namespace detail
+{
+/**
+ * @brief Читает 8 байт с невыровненного адреса (порядок байтов платформы)
+ */
+inline std::uint64_t read64(const char* p)
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/**
+ * @brief Читает 4 байта с невыровненного адреса (порядок байтов платформы)
+ */
+inline std::uint64_t read32(const char* p)
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/**
+ * @brief Перемножает a и b в 128 бит: в a записывается младшая половина, в b -- старшая
+ */
+inline void mul128(std::uint64_t& a, std::uint64_t& b)
+{
+#ifdef __SIZEOF_INT128__
+    // __extension__ убирает предупреждение -Wpedantic о нестандартном типе
+    __extension__ typedef unsigned __int128 u128;
+    const u128 r = static_cast<u128>(a) * b;
+    a = static_cast<std::uint64_t>(r);
+    b = static_cast<std::uint64_t>(r >> 64);
+#else
+    const std::uint64_t ha = a >> 32, hb = b >> 32, la = a & 0xFFFFFFFF, lb = b & 0xFFFFFFFF;
+    const std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const std::uint64_t t = rl + (rm0 << 32);
+    const std::uint64_t lo = t + (rm1 << 32);
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+    a = lo;
+#endif
+}
+
+/**
+ * @brief Перемножает a и b в 128 бит и сворачивает результат: младшая половина xor старшая
+ */
+inline std::uint64_t mum(std::uint64_t a, std::uint64_t b)
+{
+    mul128(a, b);
+    return a ^ b;
+}
+} // namespace detail
+
+/**
+ * @brief Функтор тривиального хэширования: сумма кодов символов
+ */
+struct SimpleHash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view str) const
+    {
+        std::size_t hash = 0;
+        for (char letter : str)
+            hash += static_cast<uint32_t>(letter);
+        return hash;
+    }
+};
+
+/**
+ * @brief Функтор хэш-функции rot5
+ */
+struct Rot5Hash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view str) const
+    {
+        std::size_t hash = 0;
+        for (char let : str)
+        {
+            hash += static_cast<std::uint32_t>(let);
+            hash -= (hash << 5) | (hash >> 13);
+        }
+        return hash;
+    }
+};
+
+/**
+ * @brief Функтор хэш-функции rot13
+ */
+struct Rot13Hash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view str) const
+    {
+        std::size_t hash = 0;
+        for (char c : str)
+        {
+            hash += static_cast<std::uint8_t>(c);
+            hash -= (hash << 13) | (hash >> 19);
+        }
+        return hash;
+    }
+};
+
+/**
+ * @brief Функтор хэш-функции Elf
+ */
+struct ElfHash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view str) const
+    {
+        std::size_t hash = 0, x;
+
+        for (char c : str)
+        {
+            hash = (hash << 4) + static_cast<std::size_t>(c);
+            if ((x = (hash & 0xF0000000)))
+                hash ^= x >> 24;
+            hash &= ~x;
+        }
+        return hash;
+    }
+};
+
+/**
+ * @brief Функтор улучшенной хэш-функции с меньшим числом коллизий
+ */
+struct BetterHash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view str) const
+    {
+        std::size_t hash = 0;
+        for (std::size_t i = 0; i < str.length(); ++i)
+            hash += (i * static_cast<std::size_t>(str[i]) - hash * 11) & 0xFFFFFFFF;
+        return hash;
+    }
+};
+
+/**
+ * @brief Функтор хэш-функции в стиле wyhash
+ * @details В отличие от функций выше, которые обрабатывают по одному байту и каждый шаг
+ * зависит от предыдущего, строка читается по 8 байт, а блоки по 48 байт идут
+ * тремя независимыми цепочками. Каждый шаг -- 128-битное умножение со сверткой
+ * (detail::mum). Короткие строки (до 16 байт) читаются без цикла
+ * несколькими перекрывающимися 4-байтовыми словами. Чтение зависит от порядка байтов платформы.
+ * Зерно seed меняет хэши всех ключей: подобрать ключи, совпадающие по корзинам,
+ * не зная зерна, нельзя (см. SeedMode у study::HashTable).
+ */
+struct WyHash
+{
+    using is_transparent = void;
+
+    std::uint64_t seed = 0;
+
+    std::size_t operator()(std::string_view str) const
+    {
+        constexpr std::uint64_t s0 = 0x2d358dccaa6c78a5ull, s1 = 0x8bb84b93962eacc9ull,
+                                s2 = 0x4b33a62ed433d4a3ull, s3 = 0x4d5a2da51de1aa47ull;
+        const char* p = str.data();
+        const std::size_t len = str.size();
+        std::uint64_t state = seed ^ detail::mum(seed ^ s0, s1);
+        std::uint64_t a, b;
+
+        if (len <= 16)
+        {
+            if (len >= 4)
+            {
+                const std::size_t shift = (len >> 3) << 2;
+                a = (detail::read32(p) << 32) | detail::read32(p + shift);
+                b = (detail::read32(p + len - 4) << 32) | detail::read32(p + len - 4 - shift);
+            }
+            else if (len > 0)
+            {
+                a = (std::uint64_t(static_cast<std::uint8_t>(p[0])) << 16)
+                  | (std::uint64_t(static_cast<std::uint8_t>(p[len >> 1])) << 8)
+                  | static_cast<std::uint8_t>(p[len - 1]);
+                b = 0;
+            }
+            else
+                a = b = 0;
+        }
+        else
+        {
+            std::size_t i = len;
+            if (i > 48)
+            {
+                std::uint64_t see1 = state, see2 = state;
+                do
+                {
+                    state = detail::mum(detail::read64(p) ^ s1, detail::read64(p + 8) ^ state);
+                    see1 = detail::mum(detail::read64(p + 16) ^ s2, detail::read64(p + 24) ^ see1);
+                    see2 = detail::mum(detail::read64(p + 32) ^ s3, detail::read64(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                state ^= see1 ^ see2;
+            }
+            while (i > 16)
+            {
+                state = detail::mum(detail::read64(p) ^ s1, detail::read64(p + 8) ^ state);
+                p += 16;
+                i -= 16;
+            }
+            a = detail::read64(p + i - 16);
+            b = detail::read64(p + i - 8);
+        }
+        a ^= s1;
+        b ^= state;
+        detail::mul128(a, b);
+        return static_cast<std::size_t>(detail::mum(a ^ s0 ^ len, b ^ s1));
+    }
+};
+
+/**
+ * @brief Функтор хэш-функции MurmurHash64A
+ * @details Строка читается по 8 байт, каждое слово перемешивается умножением
+ * и сдвигом; хвост короче 8 байт добавляется одним словом, в конце -- финальное
+ * перемешивание, чтобы все биты хэша зависели от всех байтов строки.
+ * Зерно seed -- начальное значение хэша.
+ */
+struct MurmurHash
+{
+    using is_transparent = void;
+
+    std::uint64_t seed = 0x9E3779B97F4A7C15ull;
+
+    std::size_t operator()(std::string_view str) const
+    {
+        constexpr std::uint64_t m = 0xc6a4a7935bd1e995ull;
+        constexpr unsigned r = 47;
+        const char* p = str.data();
+        const std::size_t len = str.size();
+        std::uint64_t hash = seed ^ (len * m);
+
+        const char* end = p + (len & ~std::size_t(7));
+        for (; p != end; p += 8)
+        {
+            std::uint64_t k = detail::read64(p);
+            k *= m;
+            k ^= k >> r;
+            k *= m;
+            hash ^= k;
+            hash *= m;
+        }
+
+        if (len & 7)
+        {
+            std::uint64_t tail = 0;
+            for (std::size_t i = 0; i < (len & 7); ++i)
+                tail |= std::uint64_t(static_cast<std::uint8_t>(p[i])) << (8 * i);
+            hash ^= tail;
+            hash *= m;
+        }
+
+        hash ^= hash >> r;
+        hash *= m;
+        hash ^= hash >> r;
+        return static_cast<std::size_t>(hash);
+    }
+};
+
 /**
  * @brief Реализует функцию тривиального хэширования
  * @param[in] str хэшируемая строка
  * @return хэш типа std::size_t
  */
-std::size_t simple_hash(const std::string& str);
+std::size_t simple_hash(std::string_view str);
 /**
  * @brief Реализует хэш-функцию rot5
  * @param[in] str хэшируемая строка
  * @return хэш типа std::size_t
  */
-std::size_t rot5_hash(const std::string& str);
+std::size_t rot5_hash(std::string_view str);
 /**
  * @brief Реализует хэш-функцию rot13
  * @param[in] str хэшируемая строка
  * @return хэш типа std::size_t
  */
-std::size_t rot13_hash(const std::string& str);
+std::size_t rot13_hash(std::string_view str);
 /**
  * @brief Реализует хэш-функцию Elf
  * @param[in] str хэшируемая строка
  * @return хэш типа std::size_t
  */
-std::size_t elf_hash(const std::string& str);
+std::size_t elf_hash(std::string_view str);
 /**
  * @brief Реализует улучшенную хэш-функцию с меньшим числом коллизий
  * @param[in] str хэшируемая строка
  * @return хэш типа std::size_t
  */
-std::size_t better_hash(const std::string& str);
+std::size_t better_hash(std::string_view str);
+/**
+ * @brief Реализует хэш-функцию в стиле wyhash
+ * @param[in] str хэшируемая строка
+ * @return хэш типа std::size_t
+ */
+std::size_t wy_hash(std::string_view str);
+/**
+ * @brief Реализует хэш-функцию MurmurHash64A
+ * @param[in] str хэшируемая строка
+ * @return хэш типа std::size_t
+ */
+std::size_t murmur_hash(std::string_view str);
 }
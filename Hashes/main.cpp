@@ -34,6 +34,72 @@ int main()
 
     statistics_to_csv<std::vector<my_tuple>>("hash_timings.csv", time_statistics);
 
+    std::cout << "\nStart collecting table statistics..." << '\n';
+    std::vector<my_tuple2> table_statistics = hash_stats_all(data, sizes);
+    statistics_to_csv<std::vector<my_tuple2>>("hash_stats.csv", table_statistics);
+
+    std::cout << "\nStart timing of hit and miss lookups..." << '\n';
+    std::vector<my_tuple> swiss_statistics = swiss_hash_timing_all(data, sizes);
+    statistics_to_csv<std::vector<my_tuple>>("hash_swiss_timings.csv", swiss_statistics);
+
+    std::cout << "\nStart timing of building..." << '\n';
+    std::vector<my_tuple> build_statistics = build_hash_timing_all(data, sizes);
+    statistics_to_csv<std::vector<my_tuple>>("hash_build_timings.csv", build_statistics);
+
+    std::cout << "\nStart timing of allocators..." << '\n';
+    std::vector<my_tuple> alloc_statistics = alloc_hash_timing_all(data, sizes);
+    statistics_to_csv<std::vector<my_tuple>>("hash_alloc_timings.csv", alloc_statistics);
+
+    std::cout << "\nStart timing of inlined and type-erased hashers..." << '\n';
+    std::vector<my_tuple> policy_statistics = search_hash_policy_timing_all(data, sizes, names);
+    statistics_to_csv<std::vector<my_tuple>>("hash_policy_timings.csv", policy_statistics);
+
+    std::cout << "\nStart timing of insert latency..." << '\n';
+    std::vector<my_tuple> latency_statistics = insert_latency_timing_all(data, sizes);
+    statistics_to_csv<std::vector<my_tuple>>("hash_insert_latency.csv", latency_statistics);
+
+    std::cout << "\nStart timing of concurrent lookups..." << '\n';
+    std::vector<my_tuple> throughput_statistics =
+            concurrent_throughput_all(data, {1, 2, 4, 8, 16, 32, 64}, {100, 90, 50});
+    statistics_to_csv<std::vector<my_tuple>>("hash_concurrent_throughput.csv", throughput_statistics);
+
+    std::cout << "\nStart timing of hashing long keys..." << '\n';
+    std::vector<my_tuple2> speed_statistics =
+            hash_throughput_all({16, 64, 256, 1024, 4096, 65536});
+    statistics_to_csv<std::vector<my_tuple2>>("hash_throughput.csv", speed_statistics);
+
+    std::cout << "\nStart timing of csv loading..." << '\n';
+    write_synthetic_csv("synthetic10M.csv", data, 10000000);
+
+    // Проходы по файлу замеряются раньше загрузок целиком, чтобы не искажать пиковый RSS
+    std::cout << "\nStart timing of streaming passes..." << '\n';
+    std::vector<my_tuple2> streaming_statistics = streaming_timing_all("synthetic10M.csv", names[0]);
+    statistics_to_csv<std::vector<my_tuple2>>("streaming_passes.csv", streaming_statistics);
+
+    std::vector<my_tuple2> loading_statistics = csv_loading_timing_all({filename, "synthetic10M.csv"});
+    statistics_to_csv<std::vector<my_tuple2>>("csv_loading_speed.csv", loading_statistics);
+
+    std::cout << "\nStart timing of binary loading..." << '\n';
+    std::vector<my_tuple> bin_loading_statistics = bin_loading_timing_all({filename, "synthetic10M.csv"});
+    statistics_to_csv<std::vector<my_tuple>>("bin_loading_times.csv", bin_loading_statistics);
+
+    std::cout << "\nStart timing of parallel csv loading..." << '\n';
+    std::vector<my_tuple2> parallel_loading_statistics =
+            csv_parallel_loading_timing_all("synthetic10M.csv", {1, 2, 4, 8, 16, 32});
+    statistics_to_csv<std::vector<my_tuple2>>("csv_parallel_loading_speed.csv", parallel_loading_statistics);
+
+    std::cout << "\nStart timing of cold start..." << '\n';
+    std::vector<my_tuple> cold_start_statistics = cold_start_timing_all(filename, "out100000.snapshot", names[0]);
+    statistics_to_csv<std::vector<my_tuple>>("hash_cold_start.csv", cold_start_statistics);
+
+    std::cout << "\nStart timing of adversarial keys..." << '\n';
+    std::vector<my_tuple> adversarial_statistics = adversarial_hash_timing_all({100, 200, 400, 600, 800, 1000});
+    statistics_to_csv<std::vector<my_tuple>>("hash_adversarial_timings.csv", adversarial_statistics);
+
+    std::cout << "\nStart analysis of hash quality..." << '\n';
+    std::vector<my_tuple2> quality_statistics = hash_quality_all(data);
+    statistics_to_csv<std::vector<my_tuple2>>("hash_quality.csv", quality_statistics);
+
     std::cout << "\nStart timing of counting collisions..." << '\n';
 
     std::vector<my_tuple2> coll_statistics = collisions_hash_count_all(data, sizes);
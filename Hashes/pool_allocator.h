@@ -0,0 +1,184 @@
+/*
+ * @file
+ * Содержит ресурсы памяти (std::pmr::memory_resource) для узлов хэш-таблицы
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
+
+namespace study
+{
+
+/**
+ * @brief Ресурс памяти, считающий выделения у вышестоящего ресурса
+ * @details Нужен для сравнения: через него таблица работает так же, как с обычными
+ * new/delete, но число выделений можно узнать.
+ */
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream)
+    {}
+
+    std::size_t allocations() const { return allocations_; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations_;
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        upstream_->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    std::size_t allocations_ = 0;
+};
+
+/**
+ * @brief Пул для мелких объектов: узлы нарезаются из больших блоков (slabs),
+ * освобожденные узлы возвращаются в список свободных своего размера, а все блоки
+ * отдаются вышестоящему ресурсу разом -- в release() или в деструкторе.
+ * @details Узлы списков хэш-таблицы (корзины и значения) -- мелкие объекты нескольких
+ * размеров, поэтому почти все выделения обслуживаются без обращения к куче, а узлы,
+ * освобожденные при rehash(), сразу идут в дело. Крупные запросы (массивы корзин)
+ * передаются вышестоящему ресурсу. Ресурс не потокобезопасен.
+ */
+class SlabResource : public std::pmr::memory_resource
+{
+public:
+    /**
+     * @param[in] slab_size размер блока в байтах; кратен 16 и не меньше самого крупного узла пула (256 байт)
+     * @param[in] upstream вышестоящий ресурс
+     * @throw std::invalid_argument, если размер блока не подходит или upstream -- nullptr
+     */
+    explicit SlabResource(std::size_t slab_size = 64 * 1024,
+                          std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : slab_size_(slab_size),
+          upstream_(upstream)
+    {
+        // Иначе узел мог бы не поместиться в новый блок, и left_ ушел бы за его конец
+        if (slab_size_ < max_pooled || slab_size_ % granularity != 0)
+            throw std::invalid_argument("SlabResource: slab size must be a multiple of 16 and at least 256 bytes");
+        if (!upstream_)
+            throw std::invalid_argument("SlabResource: upstream resource is null");
+        free_lists_.fill(nullptr);
+    }
+
+    SlabResource(const SlabResource&) = delete;
+    SlabResource& operator=(const SlabResource&) = delete;
+
+    ~SlabResource() override { release(); }
+
+    /**
+     * @brief Отдает все блоки вышестоящему ресурсу. Все выделенные из пула узлы
+     * становятся недействительными.
+     */
+    void release()
+    {
+        for (void* slab : slabs_)
+            upstream_->deallocate(slab, slab_size_, max_align);
+        slabs_.clear();
+        free_lists_.fill(nullptr);
+        current_ = nullptr;
+        left_ = 0;
+    }
+
+    /**
+     * @brief Число обращений к вышестоящему ресурсу (блоки и крупные запросы)
+     */
+    std::size_t upstream_allocations() const { return upstream_allocations_; }
+
+    /**
+     * @brief Число запросов к самому пулу
+     */
+    std::size_t allocations() const { return allocations_; }
+
+private:
+    static constexpr std::size_t granularity = 16;
+    static constexpr std::size_t max_pooled = 256;     //Запросы крупнее идут в вышестоящий ресурс
+    static constexpr std::size_t max_align = alignof(std::max_align_t);
+    static_assert(max_pooled % granularity == 0, "Pool size classes must cover max_pooled exactly");
+
+    /**
+     * @brief Узел списка свободных ячеек хранится в самой освобожденной ячейке
+     */
+    struct FreeNode
+    {
+        FreeNode* next;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations_;
+        if (bytes > max_pooled || alignment > granularity)
+        {
+            ++upstream_allocations_;
+            return upstream_->allocate(bytes, alignment);
+        }
+
+        const std::size_t size_class = (std::max<std::size_t>(bytes, 1) - 1) / granularity;
+        if (FreeNode* node = free_lists_[size_class])
+        {
+            free_lists_[size_class] = node->next;
+            return node;
+        }
+
+        const std::size_t size = (size_class + 1) * granularity;
+        if (left_ < size)
+        {
+            current_ = static_cast<std::byte*>(upstream_->allocate(slab_size_, max_align));
+            ++upstream_allocations_;
+            slabs_.push_back(current_);
+            left_ = slab_size_;
+        }
+        void* p = current_;
+        current_ += size;
+        left_ -= size;
+        return p;
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        if (bytes > max_pooled || alignment > granularity)
+        {
+            upstream_->deallocate(p, bytes, alignment);
+            return;
+        }
+
+        const std::size_t size_class = (std::max<std::size_t>(bytes, 1) - 1) / granularity;
+        free_lists_[size_class] = new (p) FreeNode{free_lists_[size_class]};
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::size_t slab_size_;
+    std::pmr::memory_resource* upstream_;
+    std::vector<void*> slabs_;
+    std::array<FreeNode*, max_pooled / granularity> free_lists_;
+    std::byte* current_ = nullptr;
+    std::size_t left_ = 0;
+    std::size_t allocations_ = 0;
+    std::size_t upstream_allocations_ = 0;
+};
+
+} //namespace study
@@ -0,0 +1,293 @@
+/*
+ * @file
+ * Содержит статический индекс на минимальной совершенной хэш-функции (в стиле PTHash)
+ */
+
+#pragma once
+
+#include "hash_table.h"
+#include "hashes.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace study
+{
+
+/**
+ * @brief Неизменяемый индекс, который строится один раз по набору значений.
+ * @details Ключи распределяются по корзинам (в среднем bucket_load ключей на корзину),
+ * и для каждой корзины, начиная с самых больших, подбирается число-"пилот", при котором
+ * все ключи корзины попадают в еще свободные ячейки. В итоге n ключей занимают ровно
+ * n ячеек без коллизий (минимальная совершенная хэш-функция), и поиск -- это вычисление
+ * хэша, чтение пилота, одна ячейка и одно сравнение ключей. Пустых корзин и цепочек нет.
+ * Значения с одинаковым ключом лежат подряд в одном массиве, в порядке их следования
+ * в исходном диапазоне.
+ * @tparam Hash функтор хэширования ключа, как у study::HashTable; ключи с одинаковым
+ * хэшем разделить нельзя, поэтому нужна хэш-функция без полных коллизий (например, WyHash)
+ */
+template <typename Key, typename T, typename Hash = std::hash<Key>>
+class StaticHashIndex
+{
+public:
+    using hash_function = Hash;
+
+    /**
+     * @brief Значения, найденные по ключу
+     */
+    class Range
+    {
+    public:
+        Range() = default;
+        Range(const T* first, const T* last) : first_(first), last_(last) {}
+
+        const T* begin() const { return first_; }
+        const T* end() const { return last_; }
+        std::size_t size() const { return static_cast<std::size_t>(last_ - first_); }
+        bool empty() const { return first_ == last_; }
+
+    private:
+        const T* first_ = nullptr;
+        const T* last_ = nullptr;
+    };
+
+    /**
+     * @brief Строит индекс по диапазону значений
+     * @param[in] first, last итераторы, указывающие на диапазон значений
+     * @param[in] extractor функция, возвращающая по значению его ключ
+     * @param[in] f хэш-функция
+     * @throw std::runtime_error, если у двух разных ключей совпали хэши или если пилоты
+     * не удалось подобрать ни при одном зерне
+     */
+    template <typename Iterator, typename KeyExtractor>
+    StaticHashIndex(Iterator first, Iterator last, KeyExtractor extractor, hash_function f = hash_function())
+        : hasher_(std::move(f))
+    {
+        // Значения группируются по ключу сортировкой по хэшу; сортировка устойчивая,
+        // чтобы значения одного ключа сохранили исходный порядок
+        std::vector<std::pair<std::uint64_t, Iterator>> items;
+        for (Iterator it = first; it != last; ++it)
+            items.emplace_back(mix(hasher_(extractor(*it))), it);
+        std::stable_sort(items.begin(), items.end(), [](const auto& lhs, const auto& rhs)
+        {
+            return lhs.first < rhs.first;
+        });
+
+        std::vector<std::size_t> group_starts;
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            if (i != 0 && items[i].first == items[i - 1].first)
+            {
+                if (extractor(*items[i].second) == extractor(*items[i - 1].second))
+                    continue;
+                throw std::runtime_error("StaticHashIndex: two keys have the same hash");
+            }
+            group_starts.push_back(i);
+        }
+        group_starts.push_back(items.size());
+
+        const std::size_t n = group_starts.size() - 1;
+        std::vector<std::uint64_t> hashes(n);
+        for (std::size_t k = 0; k < n; ++k)
+            hashes[k] = items[group_starts[k]].first;
+        const std::vector<std::size_t> slot_of = place(hashes);
+
+        value_starts_.assign(n + 1, 0);
+        for (std::size_t k = 0; k < n; ++k)
+            value_starts_[slot_of[k] + 1] = static_cast<std::uint32_t>(group_starts[k + 1] - group_starts[k]);
+        for (std::size_t slot = 1; slot <= n; ++slot)
+            value_starts_[slot] += value_starts_[slot - 1];
+
+        values_.reserve(items.size());
+        std::vector<std::size_t> group_of_slot(n);
+        for (std::size_t k = 0; k < n; ++k)
+            group_of_slot[slot_of[k]] = k;
+        for (std::size_t slot = 0; slot < n; ++slot)
+        {
+            const std::size_t k = group_of_slot[slot];
+            keys_[slot] = extractor(*items[group_starts[k]].second);
+            for (std::size_t i = group_starts[k]; i < group_starts[k + 1]; ++i)
+                values_.push_back(*items[i].second);
+        }
+    }
+
+    /**
+     * @brief Ищет в индексе все значения, соответствующие ключу
+     * @param[in] key ключ, по которому осуществляется поиск
+     * @return диапазон значений; пустой, если ключа нет
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    Range equal_range(const K& key) const
+    {
+        if (keys_.empty())
+            return Range();
+        const std::size_t slot = position(mix(hasher_(key)));
+        if (!(keys_[slot] == key))
+            return Range();
+        return Range(values_.data() + value_starts_[slot], values_.data() + value_starts_[slot + 1]);
+    }
+
+    /**
+     * @brief Проверяет, есть ли ключ в индексе
+     * @param[in] key
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    bool contains(const K& key) const
+    {
+        return !equal_range(key).empty();
+    }
+
+    /**
+     * @brief Число различных ключей
+     */
+    std::size_t size() const { return keys_.size(); }
+
+private:
+    static constexpr std::size_t bucket_load = 4;     //Ключей на корзину в среднем
+    static constexpr std::size_t max_attempts = 16;   //Попыток построения с разными зернами
+
+    /**
+     * @brief Перемешивает хэш (финализатор MurmurHash3): у слабых хэш-функций
+     * распределены плохо как старшие, так и младшие биты
+     */
+    static std::uint64_t mix(std::uint64_t hash)
+    {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ull;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    /**
+     * @brief Отображает 64-битное число в [0, range) умножением, без деления
+     */
+    static std::size_t reduce(std::uint64_t hash, std::size_t range)
+    {
+        std::uint64_t high = range;
+        detail::mul128(hash, high);
+        return static_cast<std::size_t>(high);
+    }
+
+    std::size_t bucket(std::uint64_t hash) const { return reduce(hash, pilots_.size()); }
+
+    /**
+     * @brief Ячейка ключа с хэшем hash при пилоте pilot
+     */
+    std::size_t position(std::uint64_t hash, std::uint32_t pilot) const
+    {
+        return reduce(mix(hash ^ seed_ ^ (pilot * 0x9E3779B97F4A7C15ull + 1)), keys_.size());
+    }
+
+    std::size_t position(std::uint64_t hash) const { return position(hash, pilots_[bucket(hash)]); }
+
+    /**
+     * @brief Подбирает пилоты корзин
+     * @details Перебор пилота каждой корзины ограничен; если для какой-то корзины
+     * пилот не нашелся, зерно ячеек меняется и все пилоты подбираются заново (как в PTHash).
+     * @param[in] hashes различные перемешанные хэши ключей
+     * @return ячейка для каждого ключа
+     * @throw std::runtime_error, если пилоты не нашлись ни при одном из max_attempts зерен
+     */
+    std::vector<std::size_t> place(const std::vector<std::uint64_t>& hashes)
+    {
+        std::vector<std::size_t> slot_of;
+        for (std::size_t attempt = 0; attempt < max_attempts; ++attempt)
+        {
+            seed_ = attempt == 0 ? 0 : mix(attempt * 0x9E3779B97F4A7C15ull);
+            if (try_place(hashes, slot_of))
+                return slot_of;
+        }
+        throw std::runtime_error("StaticHashIndex: cannot find pilots for the keys");
+    }
+
+    /**
+     * @brief Подбирает пилоты корзин при текущем зерне seed_
+     * @param[in] hashes различные перемешанные хэши ключей
+     * @param[out] slot_of ячейка для каждого ключа
+     * @return false, если для какой-то корзины не нашлось пилота
+     */
+    bool try_place(const std::vector<std::uint64_t>& hashes, std::vector<std::size_t>& slot_of)
+    {
+        const std::size_t n = hashes.size();
+        keys_.resize(n);
+        pilots_.assign(std::max<std::size_t>(1, (n + bucket_load - 1) / bucket_load), 0);
+        // Последние корзины из одного ключа ищут единственную свободную ячейку из n,
+        // в среднем за n попыток; с запасом в 32 раза неудача маловероятна
+        const std::uint64_t max_pilot = std::min<std::uint64_t>(UINT32_MAX, 32 * std::uint64_t(n) + 1024);
+
+        // Ключи группируются по корзинам сортировкой подсчетом
+        std::vector<std::size_t> bucket_starts(pilots_.size() + 1, 0);
+        for (std::uint64_t hash : hashes)
+            ++bucket_starts[bucket(hash) + 1];
+        for (std::size_t b = 1; b < bucket_starts.size(); ++b)
+            bucket_starts[b] += bucket_starts[b - 1];
+        std::vector<std::size_t> bucket_keys(n);
+        {
+            std::vector<std::size_t> next(bucket_starts.begin(), bucket_starts.end() - 1);
+            for (std::size_t k = 0; k < n; ++k)
+                bucket_keys[next[bucket(hashes[k])]++] = k;
+        }
+
+        // Большие корзины размещаются первыми, пока свободных ячеек много
+        std::vector<std::size_t> order(pilots_.size());
+        for (std::size_t b = 0; b < order.size(); ++b)
+            order[b] = b;
+        std::stable_sort(order.begin(), order.end(), [&bucket_starts](std::size_t lhs, std::size_t rhs)
+        {
+            return bucket_starts[lhs + 1] - bucket_starts[lhs] > bucket_starts[rhs + 1] - bucket_starts[rhs];
+        });
+
+        std::vector<bool> taken(n, false);
+        slot_of.assign(n, 0);
+        std::vector<std::size_t> candidate;
+        for (std::size_t b : order)
+        {
+            const std::size_t first = bucket_starts[b];
+            const std::size_t last = bucket_starts[b + 1];
+            if (first == last)
+                break;
+
+            for (std::uint64_t pilot = 0; ; ++pilot)
+            {
+                if (pilot == max_pilot)
+                    return false;
+                candidate.clear();
+                bool fits = true;
+                for (std::size_t i = first; i < last && fits; ++i)
+                {
+                    const std::size_t slot = position(hashes[bucket_keys[i]], static_cast<std::uint32_t>(pilot));
+                    fits = !taken[slot] && std::find(candidate.begin(), candidate.end(), slot) == candidate.end();
+                    candidate.push_back(slot);
+                }
+                if (!fits)
+                    continue;
+
+                pilots_[b] = static_cast<std::uint32_t>(pilot);
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    taken[candidate[i - first]] = true;
+                    slot_of[bucket_keys[i]] = candidate[i - first];
+                }
+                break;
+            }
+        }
+        return true;
+    }
+
+    hash_function hasher_;
+    std::uint64_t seed_ = 0;                    //Зерно ячеек, меняется при неудачном подборе пилотов
+    std::vector<std::uint32_t> pilots_;
+    std::vector<Key> keys_;                     //Ключ каждой ячейки
+    std::vector<std::uint32_t> value_starts_;   //Значения ячейки slot -- [value_starts_[slot], value_starts_[slot + 1])
+    std::vector<T> values_;
+};
+
+} //namespace study
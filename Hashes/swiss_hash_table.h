@@ -0,0 +1,271 @@
+/*
+ * @file
+ * Содержит реализацию хэш-таблицы с управляющими байтами (в стиле SwissTable)
+ */
+
+#pragma once
+
+#include "hash_table.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <vector>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define STUDY_SWISS_SSE2 1
+#endif
+
+
+namespace study
+{
+
+/**
+ * @brief Хэш-таблица с открытой адресацией, ячейки которой разбиты на группы по 16.
+ * @details Для каждой ячейки хранится управляющий байт: kEmpty для пустой ячейки или
+ * младшие 7 бит хэша (тег) для занятой. При поиске 16 тегов группы сравниваются с тегом
+ * ключа за одну SSE2-инструкцию, и ключи (std::string) сравниваются только у ячеек
+ * с совпавшим тегом -- в среднем одна лишняя проверка на 128 ячеек. Без SSE2 группа
+ * проверяется обычным циклом. Группы перебираются квадратичным пробированием.
+ * Интерфейс emplace/equal_range/find/contains/reserve совпадает с study::HashTable.
+ * @tparam Hash функтор хэширования ключа, как у study::HashTable
+ */
+template <typename Key, typename T, typename Hash = std::hash<Key>>
+class SwissHashTable
+{
+public:
+    using hash_function = Hash;
+
+    explicit SwissHashTable(hash_function f = hash_function())
+        : hasher_(std::move(f)),
+          ctrl_(group_width, kEmpty),
+          slots_(group_width)
+    {}
+
+    static inline std::list<T> empty_list{};
+
+    /**
+     * @brief Ищет в таблице все элементы, соответствующие ключу
+     * @param[in] key ключ, по которому осуществляется поиск
+     * @return std::list из значений типа T, которые хранятся по ключу key
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    const std::list<T>& equal_range(const K& key) const
+    {
+        const std::size_t pos = find_slot(key, mix(hasher_(key)));
+        return pos == npos ? empty_list : slots_[pos].values;
+    }
+
+    /**
+     * @brief Ищет в таблице значения, соответствующие ключу
+     * @param[in] key ключ, по которому осуществляется поиск
+     * @return указатель на список значений или nullptr, если ключа нет в таблице
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    const std::list<T>* find(const K& key) const
+    {
+        const std::size_t pos = find_slot(key, mix(hasher_(key)));
+        return pos == npos ? nullptr : &slots_[pos].values;
+    }
+
+    /**
+     * @brief Проверяет, есть ли ключ в таблице
+     * @param[in] key
+     */
+    template <typename K, typename = enable_if_lookup_key<K, Key, Hash>>
+    bool contains(const K& key) const
+    {
+        return find_slot(key, mix(hasher_(key))) != npos;
+    }
+
+    /**
+     * @brief Вставляет элемент с ключом и значением в хэш-таблицу
+     * @param[in] key
+     * @param[in] value
+     */
+    void emplace(const Key& key, T value)
+    {
+        std::list<T> values {value};
+        emplace(key, std::move(values));
+    }
+
+    /**
+     * @brief Вставляет элемент с ключом и списком его значений в хэш-таблицу
+     * @param[in] key
+     * @param[in] values
+     */
+    void emplace(const Key& key, std::list<T> values)
+    {
+        const std::uint64_t hash = mix(hasher_(key));
+        const std::size_t pos = find_slot(key, hash);
+        if (pos != npos)
+        {
+            for (T& value : values)
+                slots_[pos].values.emplace_front(std::move(value));
+            return;
+        }
+
+        if ((size_ + 1) * 8 > slots_.size() * 7)
+            grow(slots_.size() * 2);
+        insert_new(hash, key, std::move(values));
+    }
+
+    /**
+     * @brief Увеличивает таблицу так, чтобы count ключей поместились без ее роста
+     * @param[in] count ожидаемое число различных ключей
+     */
+    void reserve(std::size_t count)
+    {
+        std::size_t new_capacity = slots_.size();
+        while (count * 8 > new_capacity * 7)
+            new_capacity *= 2;
+        if (new_capacity != slots_.size())
+            grow(new_capacity);
+    }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return slots_.size(); }
+
+private:
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    static constexpr std::size_t group_width = 16;
+    static constexpr std::int8_t kEmpty = -128;     //0b10000000: у тегов занятых ячеек старший бит 0
+
+    struct Slot
+    {
+        Key key{};
+        std::list<T> values;
+    };
+
+    /**
+     * @brief Перемешивает хэш умножением Фибоначчи
+     * @details Тег берется из младших бит, номер группы -- из старших, а у слабых
+     * хэш-функций (например, simple_hash) и те и другие распределены плохо.
+     */
+    static std::uint64_t mix(std::size_t hash)
+    {
+        const std::uint64_t mixed = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+        return mixed ^ (mixed >> 32);
+    }
+
+    static std::int8_t tag(std::uint64_t hash) { return static_cast<std::int8_t>(hash & 0x7F); }
+
+    std::size_t group_mask() const { return slots_.size() / group_width - 1; }
+
+    /**
+     * @brief Возвращает битовую маску ячеек группы, управляющий байт которых равен byte
+     * @param[in] group указатель на первый управляющий байт группы
+     * @param[in] byte искомый байт
+     */
+    static std::uint32_t match(const std::int8_t* group, std::int8_t byte)
+    {
+#ifdef STUDY_SWISS_SSE2
+        const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(byte))));
+#else
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < group_width; ++i)
+            mask |= static_cast<std::uint32_t>(group[i] == byte) << i;
+        return mask;
+#endif
+    }
+
+    /**
+     * @brief Номер младшего установленного бита (маска не нулевая)
+     */
+    static unsigned lowest_bit(std::uint32_t mask)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+        unsigned bit = 0;
+        while (!(mask & 1u))
+        {
+            mask >>= 1;
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    /**
+     * @brief Ищет ячейку с ключом
+     * @param[in] key
+     * @param[in] hash перемешанный хэш ключа
+     * @return индекс ячейки или npos, если ключа нет в таблице
+     */
+    template <typename K>
+    std::size_t find_slot(const K& key, std::uint64_t hash) const
+    {
+        std::size_t group = static_cast<std::size_t>(hash >> 7) & group_mask();
+        for (std::size_t step = 1; ; ++step)
+        {
+            const std::int8_t* ctrl = ctrl_.data() + group * group_width;
+            for (std::uint32_t mask = match(ctrl, tag(hash)); mask != 0; mask &= mask - 1)
+            {
+                const std::size_t pos = group * group_width + lowest_bit(mask);
+                if (slots_[pos].key == key)
+                    return pos;
+            }
+            // Пустая ячейка в группе: при вставке ключ занял бы ее, дальше искать незачем
+            if (match(ctrl, kEmpty) != 0)
+                return npos;
+            group = (group + step) & group_mask();
+        }
+    }
+
+    /**
+     * @brief Вставляет ключ, которого точно нет в таблице, в первую свободную ячейку
+     * на пути пробирования
+     */
+    void insert_new(std::uint64_t hash, Key key, std::list<T> values)
+    {
+        std::size_t group = static_cast<std::size_t>(hash >> 7) & group_mask();
+        for (std::size_t step = 1; ; ++step)
+        {
+            const std::uint32_t empty = match(ctrl_.data() + group * group_width, kEmpty);
+            if (empty != 0)
+            {
+                const std::size_t pos = group * group_width + lowest_bit(empty);
+                ctrl_[pos] = tag(hash);
+                slots_[pos].key = std::move(key);
+                slots_[pos].values = std::move(values);
+                ++size_;
+                return;
+            }
+            group = (group + step) & group_mask();
+        }
+    }
+
+    /**
+     * @brief Переносит все ключи в таблицу вместимостью new_capacity ячеек
+     * @param[in] new_capacity степень двойки, кратная group_width
+     */
+    void grow(std::size_t new_capacity)
+    {
+        std::vector<std::int8_t> old_ctrl(new_capacity, kEmpty);
+        std::vector<Slot> old_slots(new_capacity);
+        std::swap(ctrl_, old_ctrl);
+        std::swap(slots_, old_slots);
+        size_ = 0;
+
+        for (std::size_t pos = 0; pos < old_slots.size(); ++pos)
+        {
+            if (old_ctrl[pos] == kEmpty)
+                continue;
+            Slot& slot = old_slots[pos];
+            const std::uint64_t hash = mix(hasher_(slot.key));
+            insert_new(hash, std::move(slot.key), std::move(slot.values));
+        }
+    }
+
+    hash_function hasher_;
+    std::vector<std::int8_t> ctrl_;
+    std::vector<Slot> slots_;
+    std::size_t size_ = 0;
+};
+
+} //namespace study
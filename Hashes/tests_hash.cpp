@@ -1,50 +1,255 @@
+#include "concurrent_hash_table.h"
 #include "entry.h"
+#include "entry_reader.h"
+#include "flat_hash_table.h"
+#include "functions.h"
+#include "hash_quality.h"
+#include "hash_snapshot.h"
 #include "hash_table.h"
 #include "hashes.h"
+#include "pool_allocator.h"
+#include "static_hash_index.h"
+#include "swiss_hash_table.h"
 #include "tests_hash.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
 #include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <stdexcept>
 #include <vector>
 #include <list>
 #include <string>
-#include <map>
-#include <numeric> //for std::accumulate
+#include <string_view>
+#include <thread>
 
 using Data = std::vector<Entry>;
 using Clock = std::chrono::high_resolution_clock;
 using my_tuple = std::tuple<std::size_t, std::string, std::uint64_t>;
 using my_tuple2 = std::tuple<std::size_t, std::string, double>;
-using my_hasher = std::function<std::size_t(Entry::Name)>;
+using my_hasher = std::function<std::size_t(const Entry::Name&)>;
 
-std::uint64_t search_hash_timing(const Data& data,
-                                 const std::size_t& size,
-                                 const std::vector<Entry::Name>& keys,
-                                 const my_hasher& hasher)
+namespace
+{
+/**
+ * @brief Заполняет хэш-таблицу первыми size записями из data, ключ -- имя
+ */
+template<typename Table>
+void fill_table(Table& htable, const Data& data, std::size_t size)
 {
-    using namespace std::chrono;
-    std::uint64_t time;
-    study::HashTable<Entry::Name, Entry> htable(hasher);
-
     Data::const_iterator data_size = std::next(data.begin(), static_cast<std::ptrdiff_t>(size));
-
-    //Заполнение хэш-таблицы
     for (Data::const_iterator it = data.begin(); it != data_size; ++it)
         htable.emplace(it->getName(), *it);
+}
 
-    std::vector<std::uint64_t> times;
-    std::uint64_t dif_t;
+/**
+ * @brief Измеряет среднее время одного поиска в хэш-таблице
+ * @details Один вызов equal_range короче разрешения часов, поэтому ключи
+ * прогоняются lookup_rounds раз и общее время делится на число поисков.
+ * @return время одного поиска в наносекундах
+ */
+template<typename Table>
+std::uint64_t lookup_timing(const Table& htable, const std::vector<Entry::Name>& keys,
+                            std::size_t lookup_rounds = 1000)
+{
+    using namespace std::chrono;
+    std::size_t found = 0;
+
+    time_point<Clock> start = Clock::now();
+    for (std::size_t round = 0; round < lookup_rounds; ++round)
+        for (const Entry::Name& key : keys)
+            found += htable.equal_range(key).size();
+    time_point<Clock> end = Clock::now();
+
+    // found используется, чтобы компилятор не выбросил поиск
+    volatile std::size_t sink = found;
+    (void)sink;
+
+    std::uint64_t total = static_cast<std::uint64_t>(duration_cast<nanoseconds>(end - start).count());
+    return total / (lookup_rounds * keys.size());
+}
+
+/**
+ * @brief Измеряет время поиска в хэш-таблице с хэш-функцией-параметром шаблона
+ * и с той же функцией, вызываемой через std::function
+ * @tparam Hash функтор хэширования из hashes.h
+ */
+template<typename Hash>
+void hash_policy_timing(const Data& data, std::size_t size, const std::vector<Entry::Name>& keys,
+                        const std::string& name, const my_hasher& erased,
+                        std::vector<my_tuple>& statistics)
+{
+    std::cout << "Running " << name << "..." << std::flush;
 
-    for (const Entry::Name& key : keys)
+    study::HashTable<Entry::Name, Entry, my_hasher> erased_table(erased);
+    fill_table(erased_table, data, size);
+    statistics.emplace_back(size, name + " (std::function)", lookup_timing(erased_table, keys));
+
+    study::HashTable<Entry::Name, Entry, Hash> inlined_table;
+    fill_table(inlined_table, data, size);
+    statistics.emplace_back(size, name + " (inlined)", lookup_timing(inlined_table, keys));
+
+    std::cout << "Done.\n";
+}
+/**
+ * @brief Сортирует хэши и считает коллизии: хэши, равные предыдущему
+ */
+std::size_t count_equal_hashes(std::vector<std::size_t>& hashes)
+{
+    std::sort(hashes.begin(), hashes.end());
+    std::size_t count = 0;
+    for (std::size_t i = 1; i < hashes.size(); ++i)
+        if (hashes[i] == hashes[i - 1])
+            ++count;
+    return count;
+}
+
+/**
+ * @brief Считает долю коллизий хэш-функции на ключах "имя + номер записи"
+ * для первых size записей
+ * @details Ключ собирается в одном переиспользуемом буфере, хэши складываются
+ * в hashes (буфер вызывающего, чтобы не выделять память на каждый вызов),
+ * затем сортируются: коллизия -- хэш, равный предыдущему. Как и прежде,
+ * ключ, совпадающий с предыдущим, не учитывается.
+ * @return число коллизий в процентах от size
+ */
+double collision_percent(const Data& data, const my_hasher& hasher, std::size_t size,
+                         std::vector<std::size_t>& hashes)
+{
+    hashes.clear();
+    hashes.reserve(size);
+    std::string key;
+    std::string previous;
+    char digits[std::numeric_limits<std::size_t>::digits10 + 1];
+
+    for (std::size_t i = 0; i < size; ++i)
     {
-        time_point<Clock> start = Clock::now();
-        const std::list<Entry>& ans = htable.equal_range(key);
-        time_point<Clock> end = Clock::now();
+        const Entry::Name& name = data[i].getName();
+        const std::to_chars_result number = std::to_chars(std::begin(digits), std::end(digits), i);
+        key.assign(name).append(digits, number.ptr);
+        if (i != 0 && key == previous)
+            continue;
+        hashes.push_back(hasher(key));
+        std::swap(key, previous);
+    }
+
+    return count_equal_hashes(hashes) * 100. / size;
+}
 
-        dif_t = static_cast<std::uint64_t>(duration_cast<nanoseconds>(end - start).count());
-        times.emplace_back(dif_t);
+/**
+ * @brief Значение поля вида "VmHWM:  1234 kB" из /proc/self/status (Linux)
+ * @return значение в килобайтах; 0, если поля нет
+ */
+std::size_t proc_status_kb(const std::string& field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+        if (line.compare(0, field.size(), field) == 0 && line.size() > field.size() && line[field.size()] == ':')
+            return std::stoul(line.substr(field.size() + 1));
+    return 0;
+}
+
+/**
+ * @brief Сбрасывает пиковый RSS процесса до текущего (Linux, /proc/self/clear_refs)
+ * @return текущий RSS в килобайтах
+ */
+std::size_t reset_peak_rss()
+{
+    std::ofstream("/proc/self/clear_refs") << "5";
+    return proc_status_kb("VmRSS");
+}
+
+/**
+ * @brief Проход линейного поиска: считает записи с именем key
+ * @return число просмотренных записей
+ */
+template <typename Range>
+std::size_t linear_search_pass(Range& entries, const Entry::Name& key, std::size_t& found)
+{
+    std::size_t rows = 0;
+    found = 0;
+    for (const Entry& entry : entries)
+    {
+        ++rows;
+        if (entry.getName() == key)
+            ++found;
+    }
+    return rows;
+}
+
+/**
+ * @brief Проход подсчета коллизий, как в collision_percent, для хэш-функции wy_hash
+ * @details Хранятся только хэши ключей (8 байт на запись), а не сами записи
+ * @return число просмотренных записей
+ */
+template <typename Range>
+std::size_t collisions_pass(Range& entries, double& percent)
+{
+    std::vector<std::size_t> hashes;
+    std::string key;
+    std::string previous;
+    char digits[std::numeric_limits<std::size_t>::digits10 + 1];
+
+    std::size_t rows = 0;
+    for (const Entry& entry : entries)
+    {
+        const std::to_chars_result number = std::to_chars(std::begin(digits), std::end(digits), rows);
+        key.assign(entry.getName()).append(digits, number.ptr);
+        if (rows++ != 0 && key == previous)
+            continue;
+        hashes.push_back(study::wy_hash(key));
+        std::swap(key, previous);
+    }
+    percent = rows == 0 ? 0 : count_equal_hashes(hashes) * 100. / rows;
+    return rows;
+}
+
+/**
+ * @brief Проход агрегации: число спортсменов и суммы возраста, роста и веса по видам спорта
+ * @return число просмотренных записей
+ */
+template <typename Range>
+std::size_t aggregation_pass(Range& entries, std::map<Entry::Sport, std::array<std::uint64_t, 4>>& totals)
+{
+    std::size_t rows = 0;
+    totals.clear();
+    for (const Entry& entry : entries)
+    {
+        ++rows;
+        std::array<std::uint64_t, 4>& total = totals[entry.getSport()];
+        ++total[0];
+        total[1] += static_cast<std::uint64_t>(entry.getAge());
+        total[2] += static_cast<std::uint64_t>(entry.getHeight());
+        total[3] += static_cast<std::uint64_t>(entry.getWeight());
     }
-    time = static_cast<std::uint64_t>(std::accumulate(times.begin(), times.end(), 0.0/times.size()));
-    return time;
+    return rows;
+}
+} // namespace
+
+std::uint64_t search_hash_timing(const Data& data,
+                                 const std::size_t& size,
+                                 const std::vector<Entry::Name>& keys,
+                                 const my_hasher& hasher)
+{
+    study::HashTable<Entry::Name, Entry, my_hasher> htable(hasher);
+    fill_table(htable, data, size);
+    return lookup_timing(htable, keys);
+}
+
+std::uint64_t search_flat_hash_timing(const Data& data,
+                                      const std::size_t& size,
+                                      const std::vector<Entry::Name>& keys,
+                                      const my_hasher& hasher)
+{
+    study::FlatHashTable<Entry::Name, Entry, my_hasher> htable(hasher);
+    fill_table(htable, data, size);
+    return lookup_timing(htable, keys);
 }
 
 std::vector<my_tuple> search_hash_timing_all(const Data& data,
@@ -52,8 +257,10 @@ std::vector<my_tuple> search_hash_timing_all(const Data& data,
                                              const std::vector<Entry::Name>& keys)
 {
     using namespace study;
-    std::vector<std::string> names = {"Simple hash", "Rot5 hash", "Rot13 hash", "Elf hash", "Better hash"};
-    std::vector<my_hasher> hashers = {simple_hash, rot5_hash, rot13_hash, elf_hash, better_hash};
+    std::vector<std::string> names = {"Simple hash", "Rot5 hash", "Rot13 hash", "Elf hash", "Better hash",
+                                      "Wy hash", "Murmur hash"};
+    std::vector<my_hasher> hashers = {simple_hash, rot5_hash, rot13_hash, elf_hash, better_hash,
+                                      wy_hash, murmur_hash};
     std::vector<std::pair<std::string, my_hasher>> names_and_hashers;
 
     for (std::size_t i = 0; i < hashers.size(); ++i)
@@ -73,74 +280,781 @@ std::vector<my_tuple> search_hash_timing_all(const Data& data,
             std::cout << "Running " << str_sort << "..." << std::flush;
             time = search_hash_timing(data, size, keys, elem.second);
             time_statistics.emplace_back(std::make_tuple(size, str_sort, time));
+            time = search_flat_hash_timing(data, size, keys, elem.second);
+            time_statistics.emplace_back(std::make_tuple(size, str_sort + " (flat)", time));
             std::cout << "Done.\n";
         }
+
+        std::cout << "Running perfect hash index..." << std::flush;
+        Data::const_iterator last = std::next(data.begin(), static_cast<std::ptrdiff_t>(size));
+        StaticHashIndex<Entry::Name, Entry, WyHash> index(data.begin(), last, [](const Entry& entry) -> const Entry::Name&
+        {
+            return entry.getName();
+        });
+        time_statistics.emplace_back(size, "Perfect index (Wy hash)", lookup_timing(index, keys));
+        std::cout << "Done.\n";
     }
     return time_statistics;
 }
 
-double collisions_hash_counting(const Data& data, const my_hasher& hasher, std::size_t size)
+std::vector<my_tuple> search_hash_policy_timing_all(const Data& data,
+                                                    const std::vector<std::size_t>& sizes,
+                                                    const std::vector<Entry::Name>& keys)
+{
+    using namespace study;
+    std::vector<my_tuple> time_statistics;
+    for (std::size_t size : sizes)
+    {
+        std::cout << "-----Size: " << size << "------\n";
+        hash_policy_timing<SimpleHash>(data, size, keys, "Simple hash", simple_hash, time_statistics);
+        hash_policy_timing<Rot5Hash>(data, size, keys, "Rot5 hash", rot5_hash, time_statistics);
+        hash_policy_timing<Rot13Hash>(data, size, keys, "Rot13 hash", rot13_hash, time_statistics);
+        hash_policy_timing<ElfHash>(data, size, keys, "Elf hash", elf_hash, time_statistics);
+        hash_policy_timing<BetterHash>(data, size, keys, "Better hash", better_hash, time_statistics);
+        hash_policy_timing<WyHash>(data, size, keys, "Wy hash", wy_hash, time_statistics);
+        hash_policy_timing<MurmurHash>(data, size, keys, "Murmur hash", murmur_hash, time_statistics);
+    }
+    return time_statistics;
+}
+
+std::vector<my_tuple> insert_latency_timing_all(const Data& data, const std::vector<std::size_t>& sizes)
+{
+    using namespace std::chrono;
+    using study::RehashMode;
+    std::vector<std::pair<std::string, RehashMode>> modes = {{"Full rehash", RehashMode::full},
+                                                             {"Incremental rehash", RehashMode::incremental}};
+    std::vector<my_tuple> latency_statistics;
+    std::vector<std::uint64_t> times;
+
+    for (std::size_t size : sizes)
+    {
+        std::cout << "-----Size: " << size << "------\n";
+
+        for (const auto& [mode_name, mode] : modes)
+        {
+            std::cout << "Running " << mode_name << "..." << std::flush;
+            study::HashTable<Entry::Name, Entry, study::BetterHash> htable(study::BetterHash(), mode);
+            times.clear();
+
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                time_point<Clock> start = Clock::now();
+                htable.emplace(data[i].getName(), data[i]);
+                time_point<Clock> end = Clock::now();
+                times.emplace_back(static_cast<std::uint64_t>(duration_cast<nanoseconds>(end - start).count()));
+            }
+
+            std::sort(times.begin(), times.end());
+            latency_statistics.emplace_back(size, mode_name + " p50", times[times.size() / 2]);
+            latency_statistics.emplace_back(size, mode_name + " p99", times[times.size() * 99 / 100]);
+            latency_statistics.emplace_back(size, mode_name + " max", times.back());
+            std::cout << "Done.\n";
+        }
+    }
+    return latency_statistics;
+}
+
+std::vector<my_tuple> concurrent_throughput_all(const Data& data,
+                                                const std::vector<std::size_t>& thread_counts,
+                                                const std::vector<std::size_t>& read_percents)
 {
-    Data::const_iterator last = data.begin() + static_cast<std::ptrdiff_t>(size);
-    Data part_data = Data(data.begin(), last);
+    using namespace std::chrono;
+    constexpr std::size_t ops_per_thread = 20000;
 
-    std::vector<std::string> vals_to_hash;
-    std::size_t i = 0;
-    for (const Entry& entry : part_data)
+    std::vector<Entry::Name> names;
+    names.reserve(data.size());
+    for (const Entry& entry : data)
+        names.push_back(entry.getName());
+
+    std::vector<my_tuple> throughput_statistics;
+
+    for (std::size_t read_percent : read_percents)
     {
-        vals_to_hash.push_back(entry.getName() + std::to_string(i));
-        ++i;
+        std::string act = std::to_string(read_percent) + "% reads";
+        std::cout << "-----" << act << "------\n";
+
+        for (std::size_t thread_count : thread_counts)
+        {
+            std::cout << "Running " << thread_count << " threads..." << std::flush;
+            study::ConcurrentHashTable<Entry::Name, Entry, study::BetterHash> htable;
+            for (const Entry& entry : data)
+                htable.emplace(entry.getName(), entry);
+
+            auto worker = [&](std::size_t seed)
+            {
+                std::uint64_t state = seed * 0x9E3779B97F4A7C15ull + 1;
+                std::size_t found = 0;
+                for (std::size_t op = 0; op < ops_per_thread; ++op)
+                {
+                    // Линейный конгруэнтный генератор: дешевле и без общего состояния между потоками
+                    state = state * 6364136223846793005ull + 1442695040888963407ull;
+                    const std::size_t i = static_cast<std::size_t>(state >> 33) % data.size();
+                    if ((state >> 20) % 100 < read_percent)
+                        found += htable.visit(names[i], [](const std::list<Entry>&) {});
+                    else
+                        htable.emplace(names[i], data[i]);
+                }
+                volatile std::size_t sink = found;
+                (void)sink;
+            };
+
+            std::vector<std::thread> threads;
+            time_point<Clock> start = Clock::now();
+            for (std::size_t t = 0; t < thread_count; ++t)
+                threads.emplace_back(worker, t);
+            for (std::thread& thread : threads)
+                thread.join();
+            time_point<Clock> end = Clock::now();
+
+            const double seconds = duration_cast<duration<double>>(end - start).count();
+            const double ops = static_cast<double>(ops_per_thread * thread_count);
+            throughput_statistics.emplace_back(thread_count, act, static_cast<std::uint64_t>(ops / seconds));
+            std::cout << "Done.\n";
+        }
     }
+    return throughput_statistics;
+}
 
-    std::vector<std::string>::iterator end_it = std::unique(vals_to_hash.begin(), vals_to_hash.end());
-    vals_to_hash.resize(static_cast<std::size_t>(std::distance(vals_to_hash.begin(), end_it)));
-    std::map<size_t, size_t> hashes_and_count;
-    std::size_t count = 0;
-    for (std::string& s : vals_to_hash)
+std::vector<my_tuple> build_hash_timing_all(const Data& data, const std::vector<std::size_t>& sizes)
+{
+    using namespace study;
+    using namespace std::chrono;
+    using Table = HashTable<Entry::Name, Entry, my_hasher>;
+    std::vector<std::string> names = {"Simple hash", "Rot5 hash", "Rot13 hash", "Elf hash", "Better hash"};
+    std::vector<my_hasher> hashers = {simple_hash, rot5_hash, rot13_hash, elf_hash, better_hash};
+
+    auto build_timing = [&data](const std::function<void(Table&, Data::const_iterator, Data::const_iterator)>& fill,
+                                const my_hasher& hasher, std::size_t size)
+    {
+        Table htable(hasher);
+        time_point<Clock> start = Clock::now();
+        fill(htable, data.begin(), std::next(data.begin(), static_cast<std::ptrdiff_t>(size)));
+        time_point<Clock> end = Clock::now();
+        return static_cast<std::uint64_t>(duration_cast<microseconds>(end - start).count());
+    };
+
+    auto emplace_loop = [](Table& htable, Data::const_iterator first, Data::const_iterator last)
+    {
+        for (; first != last; ++first)
+            htable.emplace(first->getName(), *first);
+    };
+    auto reserve_and_emplace = [&emplace_loop](Table& htable, Data::const_iterator first, Data::const_iterator last)
+    {
+        htable.reserve(static_cast<std::size_t>(std::distance(first, last)));
+        emplace_loop(htable, first, last);
+    };
+    auto bulk_build = [](Table& htable, Data::const_iterator first, Data::const_iterator last)
     {
-        size_t hash = hasher(s);
-        if (!hashes_and_count.count(hash))
+        htable.build(first, last, [](const Entry& entry) -> const Entry::Name& { return entry.getName(); });
+    };
+
+    std::vector<my_tuple> build_statistics;
+    for (std::size_t size : sizes)
+    {
+        std::cout << "-----Size: " << size << "------\n";
+
+        for (std::size_t i = 0; i < hashers.size(); ++i)
         {
-            hashes_and_count[hash] = 1;
+            std::cout << "Running " << names[i] << "..." << std::flush;
+            build_statistics.emplace_back(size, names[i] + " (emplace)", build_timing(emplace_loop, hashers[i], size));
+            build_statistics.emplace_back(size, names[i] + " (reserve + emplace)",
+                                          build_timing(reserve_and_emplace, hashers[i], size));
+            build_statistics.emplace_back(size, names[i] + " (build)", build_timing(bulk_build, hashers[i], size));
+            std::cout << "Done.\n";
         }
-        else
+
+        std::cout << "Running perfect hash index..." << std::flush;
+        Data::const_iterator last = std::next(data.begin(), static_cast<std::ptrdiff_t>(size));
+        time_point<Clock> start = Clock::now();
+        StaticHashIndex<Entry::Name, Entry, WyHash> index(data.begin(), last, [](const Entry& entry) -> const Entry::Name&
         {
-            ++hashes_and_count[hash];
-            ++count;
+            return entry.getName();
+        });
+        time_point<Clock> end = Clock::now();
+        build_statistics.emplace_back(size, "Perfect index (Wy hash) (build)",
+                                      static_cast<std::uint64_t>(duration_cast<microseconds>(end - start).count()));
+        std::cout << "Done.\n";
+
+        // При SeedMode::random переполнение корзины внутри build() меняет зерно: все ключи должны находиться
+        std::cout << "Running Wy hash random seed..." << std::flush;
+        HashTable<Entry::Name, Entry, WyHash> seeded(WyHash(), RehashMode::full, SeedMode::random);
+        start = Clock::now();
+        seeded.build(data.begin(), last, [](const Entry& entry) -> const Entry::Name& { return entry.getName(); });
+        end = Clock::now();
+        for (Data::const_iterator it = data.begin(); it != last; ++it)
+            if (!seeded.contains(it->getName()))
+                throw std::logic_error("HashTable::build lost a key with SeedMode::random");
+        build_statistics.emplace_back(size, "Wy hash random seed (build)",
+                                      static_cast<std::uint64_t>(duration_cast<microseconds>(end - start).count()));
+        std::cout << "Done.\n";
+    }
+    return build_statistics;
+}
+
+std::vector<my_tuple> swiss_hash_timing_all(const Data& data, const std::vector<std::size_t>& sizes)
+{
+    using namespace study;
+    constexpr std::size_t key_count = 1000;
+    constexpr std::size_t lookup_rounds = 20;
+    std::vector<my_tuple> time_statistics;
+
+    for (std::size_t size : sizes)
+    {
+        std::cout << "-----Size: " << size << "------\n";
+
+        // Ключи-попадания равномерно взяты из первых size записей, промахи получены
+        // из них добавлением символа, которого нет в именах
+        std::vector<Entry::Name> hit_keys;
+        std::vector<Entry::Name> miss_keys;
+        for (std::size_t i = 0; i < key_count; ++i)
+        {
+            hit_keys.push_back(data[i * size / key_count].getName());
+            miss_keys.push_back(hit_keys.back() + '#');
         }
-     }
 
-    double ans = count * 100. / size;
-    return ans;
+        std::cout << "Running chained, flat and swiss tables..." << std::flush;
+        HashTable<Entry::Name, Entry, BetterHash> chained;
+        FlatHashTable<Entry::Name, Entry, BetterHash> flat;
+        SwissHashTable<Entry::Name, Entry, BetterHash> swiss;
+        fill_table(chained, data, size);
+        fill_table(flat, data, size);
+        fill_table(swiss, data, size);
+
+        time_statistics.emplace_back(size, "Chained (hit)", lookup_timing(chained, hit_keys, lookup_rounds));
+        time_statistics.emplace_back(size, "Chained (miss)", lookup_timing(chained, miss_keys, lookup_rounds));
+        time_statistics.emplace_back(size, "Flat (hit)", lookup_timing(flat, hit_keys, lookup_rounds));
+        time_statistics.emplace_back(size, "Flat (miss)", lookup_timing(flat, miss_keys, lookup_rounds));
+        time_statistics.emplace_back(size, "Swiss (hit)", lookup_timing(swiss, hit_keys, lookup_rounds));
+        time_statistics.emplace_back(size, "Swiss (miss)", lookup_timing(swiss, miss_keys, lookup_rounds));
+        std::cout << "Done.\n";
+    }
+    return time_statistics;
 }
 
-std::vector<my_tuple2> collisions_hash_count_all(const Data& data, std::vector<std::size_t> sizes)
+std::vector<my_tuple> alloc_hash_timing_all(const Data& data, const std::vector<std::size_t>& sizes)
+{
+    using namespace study;
+    using namespace std::chrono;
+    using PmrTable = HashTable<Entry::Name, Entry, BetterHash, std::pmr::polymorphic_allocator<Entry>>;
+    std::vector<my_tuple> alloc_statistics;
+
+    auto build_timing = [&data](auto& htable, std::size_t size)
+    {
+        time_point<Clock> start = Clock::now();
+        fill_table(htable, data, size);
+        time_point<Clock> end = Clock::now();
+        return static_cast<std::uint64_t>(duration_cast<microseconds>(end - start).count());
+    };
+
+    for (std::size_t size : sizes)
+    {
+        std::cout << "-----Size: " << size << "------\n";
+        std::cout << "Running allocators..." << std::flush;
+
+        {
+            HashTable<Entry::Name, Entry, BetterHash> htable;
+            alloc_statistics.emplace_back(size, "std::allocator build", build_timing(htable, size));
+        }
+        {
+            CountingResource counting;
+            PmrTable htable(BetterHash(), RehashMode::full, &counting);
+            alloc_statistics.emplace_back(size, "new/delete build", build_timing(htable, size));
+            alloc_statistics.emplace_back(size, "new/delete allocations", counting.allocations());
+        }
+        {
+            SlabResource slabs;
+            PmrTable htable(BetterHash(), RehashMode::full, &slabs);
+            alloc_statistics.emplace_back(size, "Slab build", build_timing(htable, size));
+            alloc_statistics.emplace_back(size, "Slab allocations", slabs.upstream_allocations());
+        }
+        std::cout << "Done.\n";
+    }
+    return alloc_statistics;
+}
+
+std::vector<my_tuple2> hash_throughput_all(const std::vector<std::size_t>& key_lengths)
+{
+    using namespace study;
+    using namespace std::chrono;
+    constexpr std::size_t buffer_size = std::size_t(1) << 20;
+    constexpr std::size_t total_bytes = std::size_t(1) << 28;
+    std::vector<std::string> names = {"Simple hash", "Rot5 hash", "Rot13 hash", "Elf hash", "Better hash",
+                                      "Wy hash", "Murmur hash"};
+    std::vector<std::size_t (*)(std::string_view)> hashers = {simple_hash, rot5_hash, rot13_hash, elf_hash,
+                                                              better_hash, wy_hash, murmur_hash};
+
+    // Ключи -- подряд идущие срезы буфера, заполненного псевдослучайными буквами
+    std::string buffer(buffer_size, ' ');
+    std::uint64_t state = 1;
+    for (char& c : buffer)
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        c = static_cast<char>('a' + (state >> 33) % 26);
+    }
+
+    std::vector<my_tuple2> throughput_statistics;
+    for (std::size_t length : key_lengths)
+    {
+        std::cout << "-----Key length: " << length << "------\n";
+        const std::size_t keys_in_buffer = buffer_size / length;
+        const std::size_t rounds = std::max<std::size_t>(1, total_bytes / (keys_in_buffer * length));
+
+        for (std::size_t i = 0; i < hashers.size(); ++i)
+        {
+            std::cout << "Running " << names[i] << "..." << std::flush;
+            std::size_t result = 0;
+            time_point<Clock> start = Clock::now();
+            for (std::size_t round = 0; round < rounds; ++round)
+                for (std::size_t key = 0; key < keys_in_buffer; ++key)
+                    result ^= hashers[i](std::string_view(buffer.data() + key * length, length));
+            time_point<Clock> end = Clock::now();
+
+            volatile std::size_t sink = result;
+            (void)sink;
+
+            const double seconds = duration_cast<duration<double>>(end - start).count();
+            const double bytes = static_cast<double>(rounds * keys_in_buffer * length);
+            throughput_statistics.emplace_back(length, names[i], bytes / seconds / 1e9);
+            std::cout << "Done.\n";
+        }
+    }
+    return throughput_statistics;
+}
+
+std::vector<my_tuple2> hash_stats_all(const Data& data, const std::vector<std::size_t>& sizes)
 {
     using namespace study;
     std::vector<std::string> names = {"Simple hash", "Rot5 hash", "Rot13 hash", "Elf hash", "Better hash"};
     std::vector<my_hasher> hashers = {simple_hash, rot5_hash, rot13_hash, elf_hash, better_hash};
-    std::vector<std::pair<std::string, my_hasher>> names_and_hashers;
+    std::vector<my_tuple2> stats_statistics;
 
-    for (std::size_t i = 0; i < hashers.size(); ++i)
+    for (std::size_t size : sizes)
     {
-        names_and_hashers.emplace_back(std::make_pair(names[i], hashers[i]));
+        std::cout << "-----Size: " << size << "------\n";
+
+        for (std::size_t i = 0; i < hashers.size(); ++i)
+        {
+            std::cout << "Running " << names[i] << "..." << std::flush;
+            HashTable<Entry::Name, Entry, my_hasher> htable(hashers[i]);
+            fill_table(htable, data, size);
+            htable.track_lookups(true);
+            for (std::size_t j = 0; j < size; ++j)
+                htable.contains(data[j].getName());
+
+            const HashTableStats stats = htable.stats();
+            stats_statistics.emplace_back(size, names[i] + " load factor", stats.load_factor);
+            stats_statistics.emplace_back(size, names[i] + " buckets", stats.bucket_count);
+            stats_statistics.emplace_back(size, names[i] + " empty buckets", stats.empty_buckets);
+            stats_statistics.emplace_back(size, names[i] + " bucket size limit", stats.bucket_size);
+            stats_statistics.emplace_back(size, names[i] + " rehashes", stats.rehash_count);
+            stats_statistics.emplace_back(size, names[i] + " rehash time (ns)", stats.rehash_time);
+            stats_statistics.emplace_back(size, names[i] + " average probes", stats.average_probes);
+            for (std::size_t length = 0; length < stats.chain_lengths.size(); ++length)
+                stats_statistics.emplace_back(size, names[i] + " chain " + std::to_string(length),
+                                              stats.chain_lengths[length]);
+            std::cout << "Done.\n";
+        }
     }
+    return stats_statistics;
+}
 
-    std::vector<my_tuple2> col_statistics;
-    double percent;
+std::vector<my_tuple> adversarial_hash_timing_all(const std::vector<std::size_t>& sizes)
+{
+    using namespace study;
+    constexpr std::size_t lookup_rounds = 10;
+    // Подобранные ключи попадают в одну корзину при любом размере таблицы из
+    // последовательности 11 * 2^k вплоть до 11 * 2^8: атакующий, знающий хэш-функцию
+    // без зерна, подбирает их перебором
+    constexpr std::size_t crafted_modulus = 11 << 8;
+    const std::size_t key_count = sizes.empty() ? 0 : *std::max_element(sizes.begin(), sizes.end());
+
+    std::vector<Entry::Name> crafted;
+    for (std::size_t i = 0; crafted.size() < key_count; ++i)
+    {
+        Entry::Name key = "user" + std::to_string(i);
+        if (wy_hash(key) % crafted_modulus == 0)
+            crafted.push_back(std::move(key));
+    }
 
+    // Перестановки букв одного имени: у simple_hash хэш у всех один
+    std::vector<Entry::Name> anagrams;
+    Entry::Name letters = "Lindsay Sandoval";
+    std::sort(letters.begin(), letters.end());
+    do
+        anagrams.push_back(letters);
+    while (anagrams.size() < key_count && std::next_permutation(letters.begin(), letters.end()));
+
+    auto timing = [](auto htable, const std::vector<Entry::Name>& all_keys, std::size_t size)
+    {
+        const std::vector<Entry::Name> keys(all_keys.begin(), std::next(all_keys.begin(),
+                                                                         static_cast<std::ptrdiff_t>(size)));
+        for (const Entry::Name& key : keys)
+            htable.emplace(key, Entry(key, 0, 0, 0, ""));
+        return lookup_timing(htable, keys, lookup_rounds);
+    };
+
+    std::vector<my_tuple> time_statistics;
     for (std::size_t size : sizes)
     {
         std::cout << "-----Size: " << size << "------\n";
+        std::cout << "Running fixed and random seeds..." << std::flush;
+        time_statistics.emplace_back(size, "Wy hash fixed seed (crafted keys)",
+                                     timing(HashTable<Entry::Name, Entry, WyHash>(), crafted, size));
+        time_statistics.emplace_back(size, "Wy hash random seed (crafted keys)",
+                                     timing(HashTable<Entry::Name, Entry, WyHash>(WyHash(), RehashMode::full,
+                                                                                  SeedMode::random),
+                                            crafted, size));
+        time_statistics.emplace_back(size, "Simple hash (anagrams)",
+                                     timing(HashTable<Entry::Name, Entry, SimpleHash>(), anagrams, size));
+        time_statistics.emplace_back(size, "Wy hash random seed (anagrams)",
+                                     timing(HashTable<Entry::Name, Entry, WyHash>(WyHash(), RehashMode::full,
+                                                                                  SeedMode::random),
+                                            anagrams, size));
+        std::cout << "Done.\n";
+    }
+    return time_statistics;
+}
 
-        for (const std::pair<std::string, my_hasher>& elem : names_and_hashers)
+std::vector<my_tuple2> hash_quality_all(const Data& data)
+{
+    using namespace study;
+    constexpr std::size_t key_count = 20000;
+    constexpr std::size_t avalanche_keys = 2000;
+    const std::vector<std::size_t> table_sizes = {1024, 11264, 65536};
+    std::vector<std::string> names = {"Simple hash", "Rot5 hash", "Rot13 hash", "Elf hash", "Better hash",
+                                      "Wy hash", "Murmur hash"};
+    std::vector<std::size_t (*)(std::string_view)> hashers = {simple_hash, rot5_hash, rot13_hash, elf_hash,
+                                                              better_hash, wy_hash, murmur_hash};
+
+    // Наборы ключей: настоящие имена и синтетические ключи, на которых
+    // слабые хэш-функции ведут себя хуже всего
+    std::vector<std::pair<std::string, std::vector<std::string>>> key_sets;
+    {
+        std::vector<std::string> real;
+        for (const Entry& entry : data)
+            real.push_back(entry.getName());
+        std::sort(real.begin(), real.end());
+        real.erase(std::unique(real.begin(), real.end()), real.end());
+        key_sets.emplace_back("Names", std::move(real));
+    }
+    {
+        // Перестановки букв одного имени: у суммы кодов символов хэш у всех один
+        std::vector<std::string> anagrams;
+        std::string letters = "Lindsay Sandoval";
+        std::sort(letters.begin(), letters.end());
+        do
+            anagrams.push_back(letters);
+        while (anagrams.size() < key_count && std::next_permutation(letters.begin(), letters.end()));
+        key_sets.emplace_back("Anagrams", std::move(anagrams));
+    }
+    {
+        std::vector<std::string> sequential;
+        std::vector<std::string> long_prefix;
+        const std::string prefix(64, 'x');
+        for (std::size_t i = 0; i < key_count; ++i)
         {
-            std::string str_sort = elem.first;
-            std::cout << "Running " << str_sort << "..." << std::flush;
-            percent = collisions_hash_counting(data, elem.second, size);
-            col_statistics.emplace_back(std::make_tuple(size, str_sort, percent));
+            sequential.push_back("user" + std::to_string(i));
+            long_prefix.push_back(prefix + std::to_string(i));
+        }
+        key_sets.emplace_back("Sequential", std::move(sequential));
+        key_sets.emplace_back("Long prefix", std::move(long_prefix));
+    }
+    {
+        // Все строки из одной, двух и трех строчных латинских букв
+        std::vector<std::string> short_keys;
+        for (std::size_t length = 1; length <= 3; ++length)
+        {
+            std::string key(length, 'a');
+            for (;;)
+            {
+                short_keys.push_back(key);
+                std::size_t pos = length;
+                while (pos > 0 && key[pos - 1] == 'z')
+                    key[--pos] = 'a';
+                if (pos == 0)
+                    break;
+                ++key[pos - 1];
+            }
+        }
+        key_sets.emplace_back("Short", std::move(short_keys));
+    }
+
+    std::vector<my_tuple2> quality_statistics;
+    std::vector<std::size_t> hashes;
+    for (const auto& [set_name, keys] : key_sets)
+    {
+        std::cout << "-----Keys: " << set_name << " (" << keys.size() << ")------\n";
+        const std::vector<std::string> sample(keys.begin(),
+                                              std::next(keys.begin(), static_cast<std::ptrdiff_t>(
+                                                            std::min(avalanche_keys, keys.size()))));
+
+        for (std::size_t i = 0; i < hashers.size(); ++i)
+        {
+            std::cout << "Running " << names[i] << "..." << std::flush;
+            const std::string row = set_name + ": " + names[i];
+
+            hashes.clear();
+            for (const std::string& key : keys)
+                hashes.push_back(hashers[i](key));
+            for (std::size_t table_size : table_sizes)
+            {
+                const std::vector<std::size_t> counts = bucket_occupancy(hashes, table_size);
+                quality_statistics.emplace_back(table_size, row + " chi2", chi_squared(counts));
+                quality_statistics.emplace_back(table_size, row + " longest chain", longest_chain(counts));
+            }
+
+            const std::vector<double> bias = avalanche_bias(hashers[i], sample);
+            for (std::size_t bit = 0; bit < bias.size(); ++bit)
+                if (!std::isnan(bias[bit]))     // биты длиннее всех ключей не измерены
+                    quality_statistics.emplace_back(bit, row + " avalanche", bias[bit]);
+            std::cout << "Done.\n";
+        }
+    }
+    return quality_statistics;
+}
+
+void write_synthetic_csv(const std::string& filename, const Data& data, std::size_t rows)
+{
+    std::ofstream f(filename, std::ios::binary);
+    if (!f.is_open()) throw std::runtime_error("Cannot open output csv-file");
+
+    std::string buffer;
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        // Записи повторяются по кругу; номер круга дописывается к имени,
+        // чтобы имена не повторялись
+        const Entry& entry = data[i % data.size()];
+        buffer += entry.getName();
+        if (i >= data.size())
+            buffer += ' ' + std::to_string(i / data.size());
+        buffer += ',' + std::to_string(entry.getAge()) + ',' + std::to_string(entry.getHeight()) + ','
+                + std::to_string(entry.getWeight()) + ',' + entry.getSport() + '\n';
+        if (buffer.size() > (1 << 20))
+        {
+            f.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    f.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+std::vector<my_tuple2> csv_loading_timing_all(const std::vector<std::string>& filenames)
+{
+    using namespace std::chrono;
+    std::vector<std::pair<std::string, Data (*)(const std::string&, char)>> loaders =
+            {{"getline + istringstream", data_from_csv}, {"mmap + from_chars", data_from_csv_mmap}};
+    std::vector<my_tuple2> speed_statistics;
+
+    for (const std::string& filename : filenames)
+    {
+        std::cout << "-----File: " << filename << "------\n";
+        std::ifstream f(filename, std::ios::binary | std::ios::ate);
+        if (!f.is_open()) throw std::runtime_error("Cannot open input csv-file");
+        const double megabytes = static_cast<double>(f.tellg()) / (1 << 20);
+
+        for (const auto& [loader_name, loader] : loaders)
+        {
+            std::cout << "Running " << loader_name << "..." << std::flush;
+            time_point<Clock> start = Clock::now();
+            const Data data = loader(filename, ',');
+            time_point<Clock> end = Clock::now();
+
+            const double seconds = duration_cast<duration<double>>(end - start).count();
+            speed_statistics.emplace_back(data.size(), filename + " " + loader_name, megabytes / seconds);
             std::cout << "Done.\n";
         }
     }
+    return speed_statistics;
+}
+
+std::vector<my_tuple> bin_loading_timing_all(const std::vector<std::string>& filenames)
+{
+    using namespace std::chrono;
+    std::vector<my_tuple> time_statistics;
+
+    for (const std::string& filename : filenames)
+    {
+        std::cout << "-----File: " << filename << "------\n";
+        const std::string bin_filename = filename.substr(0, filename.rfind('.')) + ".bin";
+        csv_to_bin(filename, bin_filename);
+
+        std::vector<std::pair<std::string, std::function<Data()>>> loaders =
+        {
+            {"getline + istringstream", [&filename]() { return data_from_csv(filename); }},
+            {"mmap + from_chars", [&filename]() { return data_from_csv_mmap(filename); }},
+            {"binary", [&bin_filename]() { return data_from_bin(bin_filename); }}
+        };
+        for (const auto& [loader_name, loader] : loaders)
+        {
+            std::cout << "Running " << loader_name << "..." << std::flush;
+            time_point<Clock> start = Clock::now();
+            const Data data = loader();
+            time_point<Clock> end = Clock::now();
+
+            time_statistics.emplace_back(data.size(), filename + " " + loader_name,
+                                         duration_cast<milliseconds>(end - start).count());
+            std::cout << "Done.\n";
+        }
+    }
+    return time_statistics;
+}
+
+std::vector<my_tuple2> streaming_timing_all(const std::string& filename, const Entry::Name& key)
+{
+    using namespace std::chrono;
+    std::ifstream f(filename, std::ios::binary | std::ios::ate);
+    if (!f.is_open()) throw std::runtime_error("Cannot open input csv-file");
+    const double megabytes = static_cast<double>(f.tellg()) / (1 << 20);
+
+    std::vector<my_tuple2> statistics;
+    std::size_t found = 0;
+    double percent = 0;
+    std::map<Entry::Sport, std::array<std::uint64_t, 4>> totals;
+
+    // Каждый проход выполняется по EntryReader и по вектору, загруженному целиком. Сначала
+    // идут все проходы по EntryReader: освобожденная после загрузки целиком память остается
+    // в куче процесса и скрыла бы рост RSS у следующих проходов
+    auto run = [&](bool streaming, const std::string& pass_name, auto pass)
+    {
+        const std::string act = (streaming ? "stream " : "in-memory ") + pass_name;
+        std::cout << "Running " << act << "..." << std::flush;
+        const std::size_t rss_before = reset_peak_rss();
+        time_point<Clock> start = Clock::now();
+        std::size_t rows = 0;
+        if (streaming)
+        {
+            EntryReader reader(filename);
+            rows = pass(reader);
+        }
+        else
+        {
+            Data data = data_from_csv_mmap(filename);
+            rows = pass(data);
+        }
+        time_point<Clock> end = Clock::now();
+        const std::size_t rss_peak = proc_status_kb("VmHWM");
+
+        const double seconds = duration_cast<duration<double>>(end - start).count();
+        statistics.emplace_back(rows, act + " MB/s", megabytes / seconds);
+        statistics.emplace_back(rows, act + " peak RSS growth KB",
+                                static_cast<double>(rss_peak > rss_before ? rss_peak - rss_before : 0));
+        std::cout << "Done.\n";
+    };
+
+    for (const bool streaming : {true, false})
+    {
+        run(streaming, "linear search", [&](auto& entries) { return linear_search_pass(entries, key, found); });
+        run(streaming, "collisions", [&](auto& entries) { return collisions_pass(entries, percent); });
+        run(streaming, "aggregation", [&](auto& entries) { return aggregation_pass(entries, totals); });
+    }
+    return statistics;
+}
+
+std::vector<my_tuple2> csv_parallel_loading_timing_all(const std::string& filename,
+                                                       const std::vector<std::size_t>& thread_counts)
+{
+    using namespace std::chrono;
+    std::ifstream f(filename, std::ios::binary | std::ios::ate);
+    if (!f.is_open()) throw std::runtime_error("Cannot open input csv-file");
+    const double megabytes = static_cast<double>(f.tellg()) / (1 << 20);
+
+    std::vector<my_tuple2> speed_statistics;
+    for (std::size_t thread_count : thread_counts)
+    {
+        std::cout << "Running " << thread_count << " threads..." << std::flush;
+        time_point<Clock> start = Clock::now();
+        const Data data = data_from_csv_parallel(filename, thread_count);
+        time_point<Clock> end = Clock::now();
+
+        const double seconds = duration_cast<duration<double>>(end - start).count();
+        speed_statistics.emplace_back(thread_count, filename, megabytes / seconds);
+        std::cout << "Done.\n";
+    }
+    return speed_statistics;
+}
+
+std::vector<my_tuple> cold_start_timing_all(const std::string& csv_filename,
+                                            const std::string& snapshot_filename,
+                                            const Entry::Name& key)
+{
+    using namespace study;
+    using namespace std::chrono;
+    using Table = HashTable<Entry::Name, Entry, WyHash>;
+    std::vector<my_tuple> time_statistics;
+
+    std::cout << "Running csv + emplace..." << std::flush;
+    time_point<Clock> start = Clock::now();
+    Data data = data_from_csv(csv_filename);
+    Table htable;
+    fill_table(htable, data, data.size());
+    std::size_t found = htable.equal_range(key).size();
+    time_point<Clock> end = Clock::now();
+    time_statistics.emplace_back(data.size(), "CSV + emplace",
+                                 static_cast<std::uint64_t>(duration_cast<microseconds>(end - start).count()));
+    std::cout << "Done.\n";
+
+    std::cout << "Running snapshot..." << std::flush;
+    start = Clock::now();
+    HashSnapshot<WyHash>::write(snapshot_filename, htable);
+    end = Clock::now();
+    time_statistics.emplace_back(data.size(), "Snapshot write",
+                                 static_cast<std::uint64_t>(duration_cast<microseconds>(end - start).count()));
+
+    start = Clock::now();
+    HashSnapshot<WyHash> snapshot(snapshot_filename);
+    found += snapshot.equal_range(key).size();
+    end = Clock::now();
+    time_statistics.emplace_back(data.size(), "Snapshot mmap",
+                                 static_cast<std::uint64_t>(duration_cast<microseconds>(end - start).count()));
+    std::cout << "Done.\n";
+
+    volatile std::size_t sink = found;
+    (void)sink;
+    return time_statistics;
+}
+
+double collisions_hash_counting(const Data& data, const my_hasher& hasher, std::size_t size)
+{
+    std::vector<std::size_t> hashes;
+    return collision_percent(data, hasher, size, hashes);
+}
+
+std::vector<my_tuple2> collisions_hash_count_all(const Data& data, std::vector<std::size_t> sizes)
+{
+    using namespace study;
+    std::vector<std::string> names = {"Simple hash", "Rot5 hash", "Rot13 hash", "Elf hash", "Better hash",
+                                      "Wy hash", "Murmur hash"};
+    std::vector<my_hasher> hashers = {simple_hash, rot5_hash, rot13_hash, elf_hash, better_hash,
+                                      wy_hash, murmur_hash};
+
+    // Задачи (размер, хэш-функция) разбираются потоками по атомарному счетчику,
+    // результат каждой пишется в свою ячейку, поэтому порядок строк не меняется
+    const std::size_t task_count = sizes.size() * hashers.size();
+    std::vector<double> percents(task_count);
+    std::atomic<std::size_t> next_task{0};
+
+    auto worker = [&]()
+    {
+        std::vector<std::size_t> hashes;
+        for (std::size_t task = next_task++; task < task_count; task = next_task++)
+        {
+            const std::size_t size = sizes[task / hashers.size()];
+            percents[task] = collision_percent(data, hashers[task % hashers.size()], size, hashes);
+        }
+    };
+
+    const std::size_t thread_count = std::min<std::size_t>(task_count,
+                                                           std::max(1u, std::thread::hardware_concurrency()));
+    std::cout << "Running " << task_count << " tasks on " << thread_count << " threads..." << std::flush;
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thread_count; ++t)
+        threads.emplace_back(worker);
+    for (std::thread& thread : threads)
+        thread.join();
+    std::cout << "Done.\n";
+
+    std::vector<my_tuple2> col_statistics;
+    for (std::size_t task = 0; task < task_count; ++task)
+        col_statistics.emplace_back(sizes[task / hashers.size()], names[task % hashers.size()], percents[task]);
     return col_statistics;
 }
@@ -6,7 +6,7 @@
 using Data = std::vector<Entry>;
 using my_tuple = std::tuple<std::size_t, std::string, std::uint64_t>;
 using my_tuple2 = std::tuple<std::size_t, std::string, double>;
-using my_hasher = std::function<std::size_t(Entry::Name)>;
+using my_hasher = std::function<std::size_t(const Entry::Name&)>;
 
 /**
  * @brief search_hash_timing
@@ -14,15 +14,31 @@ using my_hasher = std::function<std::size_t(Entry::Name)>;
  * @param size
  * @param keys
  * @param hasher
- * @return число std::uint64_t -- время, затраченное на поиск в хэш-таблице
+ * @return число std::uint64_t -- время одного поиска (нс) в хэш-таблице с цепочками
  */
 std::uint64_t search_hash_timing(const Data& data,
                                  const std::size_t& size,
                                  const std::vector<Entry::Name>& keys,
                                  const my_hasher& hasher);
 
+/**
+ * @brief search_flat_hash_timing
+ * @param data
+ * @param size
+ * @param keys
+ * @param hasher
+ * @return число std::uint64_t -- время одного поиска (нс) в хэш-таблице с открытой адресацией
+ */
+std::uint64_t search_flat_hash_timing(const Data& data,
+                                      const std::size_t& size,
+                                      const std::vector<Entry::Name>& keys,
+                                      const my_hasher& hasher);
+
 /**
  * @brief search_hash_timing_all
+ * @details Кроме хэш-таблиц с каждой хэш-функцией измеряется поиск в статическом
+ * индексе study::StaticHashIndex (строки "Perfect index"); время его построения --
+ * в build_hash_timing_all.
  * @param data
  * @param sizes
  * @param keys
@@ -32,6 +48,174 @@ std::vector<my_tuple> search_hash_timing_all(const Data& data,
                                              const std::vector<std::size_t>& sizes,
                                              const std::vector<Entry::Name>& keys);
 
+/**
+ * @brief Сравнивает время поиска при вызове хэш-функции через std::function
+ * и при хэш-функции-параметре шаблона, которую компилятор может встроить
+ * @param data
+ * @param sizes
+ * @param keys
+ * @return вектор (размер, хэш-функция и способ вызова, время одного поиска в нс)
+ */
+std::vector<my_tuple> search_hash_policy_timing_all(const Data& data,
+                                                    const std::vector<std::size_t>& sizes,
+                                                    const std::vector<Entry::Name>& keys);
+
+/**
+ * @brief Измеряет задержку каждой вставки в хэш-таблицу при полном и
+ * инкрементальном перехэшировании
+ * @param data
+ * @param sizes
+ * @return вектор (размер, режим и перцентиль p50/p99/max, задержка вставки в нс)
+ */
+std::vector<my_tuple> insert_latency_timing_all(const Data& data, const std::vector<std::size_t>& sizes);
+
+/**
+ * @brief Измеряет пропускную способность study::ConcurrentHashTable при разном числе
+ * потоков и разной доле чтений среди операций
+ * @param data данные, которыми заполняется таблица и по именам из которых идет поиск
+ * @param thread_counts числа потоков
+ * @param read_percents доли чтений в процентах, остальные операции -- вставки
+ * @return вектор (число потоков, доля чтений, операций в секунду)
+ */
+std::vector<my_tuple> concurrent_throughput_all(const Data& data,
+                                                const std::vector<std::size_t>& thread_counts,
+                                                const std::vector<std::size_t>& read_percents);
+
+/**
+ * @brief Измеряет время заполнения хэш-таблицы: вставками по одной,
+ * вставками после reserve() и одним вызовом build(), а также время построения
+ * статического индекса study::StaticHashIndex. Таблица со случайным зерном (SeedMode::random)
+ * после build() проверяется поиском каждого ключа
+ * @param data
+ * @param sizes
+ * @return вектор (размер, хэш-функция и способ заполнения, время в мкс)
+ * @throw std::logic_error, если build() потерял ключ
+ */
+std::vector<my_tuple> build_hash_timing_all(const Data& data, const std::vector<std::size_t>& sizes);
+
+/**
+ * @brief Сравнивает время поиска в хэш-таблицах с цепочками, с открытой адресацией
+ * и с управляющими байтами (study::SwissHashTable) на ключах, которые есть
+ * в таблице, и на ключах, которых в ней нет
+ * @param data
+ * @param sizes
+ * @return вектор (размер, таблица и вид ключей, время одного поиска в нс)
+ */
+std::vector<my_tuple> swiss_hash_timing_all(const Data& data, const std::vector<std::size_t>& sizes);
+
+/**
+ * @brief Сравнивает заполнение хэш-таблицы с обычным выделением памяти
+ * и с пулом study::SlabResource
+ * @details Учитываются выделения узлов и массивов корзин таблицы; память под сами
+ * ключи std::string выделяется отдельно и не считается.
+ * @param data
+ * @param sizes
+ * @return вектор (размер, способ выделения и величина, время в мкс или число выделений у кучи)
+ */
+std::vector<my_tuple> alloc_hash_timing_all(const Data& data, const std::vector<std::size_t>& sizes);
+
+/**
+ * @brief Измеряет скорость хэш-функций на длинных ключах
+ * @param key_lengths длины ключей в байтах
+ * @return вектор (длина ключа, хэш-функция, скорость в ГБ/с)
+ */
+std::vector<my_tuple2> hash_throughput_all(const std::vector<std::size_t>& key_lengths);
+
+/**
+ * @brief Собирает статистику study::HashTable::stats() для каждой хэш-функции и размера
+ * @details Таблица заполняется первыми size записями, затем по одному разу ищется
+ * каждое вставленное имя, чтобы получить среднее число сравнений при поиске.
+ * Гистограмма длин цепочек выводится строками "<хэш-функция> chain <длина>".
+ * @param data
+ * @param sizes
+ * @return вектор (размер, хэш-функция и величина, значение)
+ */
+std::vector<my_tuple2> hash_stats_all(const Data& data, const std::vector<std::size_t>& sizes);
+
+/**
+ * @brief Измеряет время поиска на ключах, подобранных против хэш-функции:
+ * с фиксированным зерном они все попадают в одну корзину, и цепочка растет
+ * с числом ключей, а со случайным зерном (SeedMode::random) время поиска не меняется
+ * @param sizes числа ключей; время заполнения таблицы с фиксированным зерном
+ * растет быстрее квадрата числа ключей, поэтому они должны быть небольшими
+ * @return вектор (число ключей, хэш-функция и набор ключей, время одного поиска в нс)
+ */
+std::vector<my_tuple> adversarial_hash_timing_all(const std::vector<std::size_t>& sizes);
+
+/**
+ * @brief Оценивает качество хэш-функций из hashes.h на настоящих именах и на
+ * синтетических ключах (перестановки букв, последовательные номера, длинный общий
+ * префикс, короткие строки)
+ * @details Для нескольких размеров таблицы считаются хи-квадрат заполненности корзин
+ * (нормированный, у равномерной функции около 1) и самая длинная цепочка при
+ * индексе hash % размер, как в study::HashTable; для каждого из первых 128 бит
+ * ключа -- смещение лавинного эффекта (см. study::avalanche_bias); биты, которых нет
+ * ни в одном ключе набора, в результат не попадают.
+ * @param data
+ * @return вектор (размер таблицы или номер входного бита, "ключи: хэш-функция величина", значение)
+ */
+std::vector<my_tuple2> hash_quality_all(const Data& data);
+
+/**
+ * @brief Записывает csv-файл из rows строк, повторяя записи data по кругу
+ * @details Начиная со второго круга к имени дописывается номер круга.
+ * @param filename имя файла
+ * @param data исходные записи
+ * @param rows число строк
+ */
+void write_synthetic_csv(const std::string& filename, const Data& data, std::size_t rows);
+
+/**
+ * @brief Сравнивает скорость чтения csv-файлов функциями data_from_csv и data_from_csv_mmap
+ * @param filenames csv-файлы
+ * @return вектор (число записей, файл и способ чтения, скорость в МБ/с)
+ */
+std::vector<my_tuple2> csv_loading_timing_all(const std::vector<std::string>& filenames);
+
+/**
+ * @brief Сравнивает однопроходную обработку csv-файла через EntryReader с загрузкой файла целиком
+ * @details Три прохода: линейный поиск по имени, подсчет коллизий wy_hash (как в
+ * collisions_hash_counting) и суммы по видам спорта. Каждый выполняется по EntryReader
+ * и по вектору из data_from_csv_mmap; замеряются скорость и прирост пикового RSS
+ * (Linux: сброс через /proc/self/clear_refs, пик -- VmHWM из /proc/self/status).
+ * @param filename csv-файл
+ * @param key имя для линейного поиска
+ * @return вектор (число записей, проход и величина, значение): скорость в МБ/с и прирост RSS в КБ
+ */
+std::vector<my_tuple2> streaming_timing_all(const std::string& filename, const Entry::Name& key);
+
+/**
+ * @brief Сравнивает время загрузки данных из csv-файлов и из их двоичных копий (data_from_bin)
+ * @details Каждый файл переводится в двоичный формат функцией csv_to_bin (файл с тем же
+ * именем и расширением .bin), затем замеряются data_from_csv, data_from_csv_mmap и data_from_bin.
+ * @param filenames csv-файлы
+ * @return вектор (число записей, файл и способ загрузки, время в мс)
+ */
+std::vector<my_tuple> bin_loading_timing_all(const std::vector<std::string>& filenames);
+
+/**
+ * @brief Измеряет скорость чтения csv-файла функцией data_from_csv_parallel при разном числе потоков
+ * @param filename csv-файл
+ * @param thread_counts числа потоков
+ * @return вектор (число потоков, файл, скорость в МБ/с)
+ */
+std::vector<my_tuple2> csv_parallel_loading_timing_all(const std::string& filename,
+                                                       const std::vector<std::size_t>& thread_counts);
+
+/**
+ * @brief Сравнивает время от запуска до первого ответа на поиск: чтение csv-файла
+ * со вставкой записей в хэш-таблицу и открытие снимка study::HashSnapshot
+ * @details Снимок записывается из таблицы, построенной по тому же csv-файлу.
+ * Файлы читаются из кэша страниц ОС, поэтому сравнивается работа процесса, а не диска.
+ * @param csv_filename csv-файл с данными
+ * @param snapshot_filename файл, в который записывается снимок
+ * @param key ключ первого поиска
+ * @return вектор (число записей, способ запуска, время в мкс)
+ */
+std::vector<my_tuple> cold_start_timing_all(const std::string& csv_filename,
+                                            const std::string& snapshot_filename,
+                                            const Entry::Name& key);
+
 /**
  * @brief collisions_hash_counting
  * @param data
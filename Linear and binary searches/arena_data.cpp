@@ -0,0 +1,52 @@
+/**
+  * @file
+  * @brief Файл исходного кода, содержащий определения методов классов StringArena и ArenaData
+  */
+
+#include "arena_data.h"
+#include <cstring>
+#include <tuple>
+
+std::string_view StringArena::store(std::string_view str)
+{
+    if (str.empty())
+        return std::string_view();
+    if (str.size() > block_size)
+    {
+        // Длинная строка получает собственный блок, а текущий блок продолжает заполняться
+        blocks_.push_back(std::make_unique<char[]>(str.size()));
+        capacity_ += str.size();
+        std::memcpy(blocks_.back().get(), str.data(), str.size());
+        return std::string_view(blocks_.back().get(), str.size());
+    }
+    if (str.size() > left_)
+    {
+        blocks_.push_back(std::make_unique<char[]>(block_size));
+        capacity_ += block_size;
+        cur_ = blocks_.back().get();
+        left_ = block_size;
+    }
+    std::memcpy(cur_, str.data(), str.size());
+    const std::string_view stored(cur_, str.size());
+    cur_ += str.size();
+    left_ -= str.size();
+    return stored;
+}
+
+void ArenaData::emplace_back(std::string_view name, Entry::Age age, Entry::Height height,
+                             Entry::Weight weight, std::string_view sport)
+{
+    auto it = sports_.find(sport);
+    if (it == sports_.end())
+    {
+        const std::string_view stored = arena_.store(sport);
+        it = sports_.emplace(stored, stored).first;
+    }
+    entries_.emplace_back(arena_.store(name), age, height, weight, it->second);
+}
+
+bool operator<(const ArenaEntry& lhs, const ArenaEntry& rhs)
+{
+    return std::tie(lhs.sport_, lhs.name_, lhs.age_) <
+           std::tie(rhs.sport_, rhs.name_, rhs.age_);
+}
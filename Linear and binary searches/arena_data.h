@@ -0,0 +1,142 @@
+/**
+  * @file
+  * @brief Заголовочный файл, содержащий определения классов StringArena, ArenaEntry и ArenaData --
+  * набора записей, строки которого лежат в общей арене
+  */
+
+#pragma once
+
+#include "entry.h"
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class StringArena
+ * @brief Арена для строк: символы копируются подряд в большие блоки, освобождаются все разом
+ * @details Блоки не перемещаются и не освобождаются до уничтожения арены, поэтому
+ * выданные std::string_view остаются действительными все это время (в том числе
+ * после перемещения арены).
+ */
+class StringArena
+{
+public:
+    StringArena() = default;
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+    StringArena(StringArena&&) = default;
+    StringArena& operator=(StringArena&&) = default;
+
+    /**
+     * @brief Копирует строку в арену
+     * @param[in] str строка
+     * @return представление копии строки в арене
+     */
+    std::string_view store(std::string_view str);
+
+    /**
+     * @brief Суммарный размер выделенных блоков в байтах
+     */
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    static constexpr std::size_t block_size = 1 << 16;
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* cur_ = nullptr;
+    std::size_t left_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+/**
+ * @class ArenaEntry
+ * @brief То же, что Entry, но имя и вид спорта -- представления строк из арены ArenaData
+ */
+class ArenaEntry
+{
+public:
+    ArenaEntry(std::string_view name, Entry::Age age, Entry::Height height,
+               Entry::Weight weight, std::string_view sport)
+        : name_(name)
+        , age_(age)
+        , height_(height)
+        , weight_(weight)
+        , sport_(sport)
+    {}
+
+    std::string_view getName()   const { return name_; }
+    Entry::Age       getAge()    const { return age_; }
+    Entry::Height    getHeight() const { return height_; }
+    Entry::Weight    getWeight() const { return weight_; }
+    std::string_view getSport()  const { return sport_; }
+
+    /**
+     * @brief Порядок тот же, что и у Entry: вид спорта, имя, возраст
+     */
+    friend bool operator<(const ArenaEntry& lhs, const ArenaEntry& rhs);
+
+private:
+    std::string_view name_;
+    Entry::Age age_;
+    Entry::Height height_;
+    Entry::Weight weight_;
+    std::string_view sport_;
+};
+
+/**
+ * @class ArenaData
+ * @brief Набор записей ArenaEntry вместе с ареной, в которой лежат их строки
+ * @details Имена копируются в арену; каждый вид спорта хранится в арене один раз.
+ * Записи ссылаются на арену, поэтому набор нельзя копировать, только перемещать.
+ */
+class ArenaData
+{
+public:
+    using value_type     = ArenaEntry;
+    using const_iterator = std::vector<ArenaEntry>::const_iterator;
+
+    ArenaData() = default;
+    ArenaData(const ArenaData&) = delete;
+    ArenaData& operator=(const ArenaData&) = delete;
+    ArenaData(ArenaData&&) = default;
+    ArenaData& operator=(ArenaData&&) = default;
+
+    /**
+     * @brief Раскладывает записи Entry в арену
+     * @param[in] first, last итераторы, указывающие на диапазон объектов класса Entry
+     */
+    template<typename Iterator>
+    ArenaData(Iterator first, Iterator last)
+    {
+        reserve(static_cast<std::size_t>(std::distance(first, last)));
+        for (; first != last; ++first)
+            emplace_back(first->getName(), first->getAge(), first->getHeight(), first->getWeight(), first->getSport());
+    }
+
+    void reserve(std::size_t size) { entries_.reserve(size); }
+
+    /**
+     * @brief Добавляет запись, копируя строки в арену
+     */
+    void emplace_back(std::string_view name, Entry::Age age, Entry::Height height,
+                      Entry::Weight weight, std::string_view sport);
+
+    std::size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    const ArenaEntry& operator[](std::size_t index) const { return entries_[index]; }
+    const_iterator begin() const { return entries_.begin(); }
+    const_iterator end() const { return entries_.end(); }
+
+    /**
+     * @brief Записи набора; их можно копировать и сортировать, пока жив набор
+     */
+    const std::vector<ArenaEntry>& entries() const { return entries_; }
+
+private:
+    StringArena arena_;
+    std::vector<ArenaEntry> entries_;
+    std::unordered_map<std::string_view, std::string_view> sports_; //Вид спорта -> его копия в арене
+};
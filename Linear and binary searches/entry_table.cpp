@@ -0,0 +1,83 @@
+/**
+  * @file
+  * @brief Файл исходного кода, содержащий определения методов класса EntryTable
+  */
+
+#include "entry_table.h"
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+void EntryTable::reserve(std::size_t size)
+{
+    name_offsets_.reserve(size + 1);
+    ages_.reserve(size);
+    heights_.reserve(size);
+    weights_.reserve(size);
+    sport_codes_.reserve(size);
+}
+
+void EntryTable::push_back(const Entry& entry)
+{
+    // Все проверки выполняются до изменения столбцов, чтобы исключение не оставило таблицу несогласованной
+    if (entry.getName().size() > std::numeric_limits<std::uint32_t>::max() - names_.size())
+        throw std::length_error("EntryTable: names do not fit into 32-bit offsets");
+
+    const std::string_view sport = entry.getSport();
+    auto it = sport_index_.find(sport);
+    if (it == sport_index_.end())
+    {
+        // Коды 0..65535: 65537-й вид спорта уже не помещается в SportCode
+        if (sports_.size() > std::numeric_limits<SportCode>::max())
+            throw std::length_error("EntryTable: more than 65536 different sports");
+        it = sport_index_.emplace(Entry::Sport(sport), static_cast<SportCode>(sports_.size())).first;
+        sports_.emplace_back(sport);
+    }
+
+    names_ += entry.getName();
+    name_offsets_.push_back(static_cast<std::uint32_t>(names_.size()));
+    ages_.push_back(entry.getAge());
+    heights_.push_back(entry.getHeight());
+    weights_.push_back(entry.getWeight());
+    sport_codes_.push_back(it->second);
+}
+
+EntryTable EntryTable::head(std::size_t count) const
+{
+    if (count > size())
+        throw std::out_of_range("EntryTable: head is longer than the table");
+
+    EntryTable part;
+    part.names_.assign(names_, 0, name_offsets_[count]);
+    part.name_offsets_.assign(name_offsets_.begin(), name_offsets_.begin() + static_cast<std::ptrdiff_t>(count) + 1);
+    part.ages_.assign(ages_.begin(), ages_.begin() + static_cast<std::ptrdiff_t>(count));
+    part.heights_.assign(heights_.begin(), heights_.begin() + static_cast<std::ptrdiff_t>(count));
+    part.weights_.assign(weights_.begin(), weights_.begin() + static_cast<std::ptrdiff_t>(count));
+    part.sport_codes_.assign(sport_codes_.begin(), sport_codes_.begin() + static_cast<std::ptrdiff_t>(count));
+    part.sports_ = sports_;
+    part.sport_index_ = sport_index_;
+    return part;
+}
+
+std::vector<Entry> EntryTable::to_data() const
+{
+    std::vector<Entry> data;
+    data.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i)
+        data.push_back((*this)[i].to_entry());
+    return data;
+}
+
+Entry EntryTable::Row::to_entry() const
+{
+    return Entry(Entry::Name(getName()), getAge(), getHeight(), getWeight(), Entry::Sport(getSport()));
+}
+
+bool operator<(const EntryTable::Row& lhs, const EntryTable::Row& rhs)
+{
+    // Коды видов спорта идут в порядке появления, а не по алфавиту, поэтому сравниваются строки
+    return std::make_tuple(lhs.getSport(), lhs.getName(), lhs.getAge()) <
+           std::make_tuple(rhs.getSport(), rhs.getName(), rhs.getAge());
+}
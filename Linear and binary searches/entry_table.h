@@ -0,0 +1,204 @@
+/**
+  * @file
+  * @brief Заголовочный файл, содержащий определение класса EntryTable -- поколоночного хранилища записей
+  */
+
+#pragma once
+
+#include "entry.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class EntryTable
+ * @brief Те же данные, что и в std::vector<Entry>, но разложенные по столбцам
+ * @details Имена лежат подряд в одном буфере символов, начало каждого имени задается
+ * массивом смещений; возраст, рост и вес -- отдельные массивы int; вид спорта хранится
+ * кодом из словаря различных видов спорта. Поиск по имени читает только буфер имен и
+ * смещения, не затрагивая остальные поля.
+ * Строка таблицы доступна через легкий объект EntryTable::Row с теми же методами чтения,
+ * что и у Entry, поэтому study::linear_search и study::binary_search работают с таблицей
+ * напрямую. Сортируется не сама таблица, а вектор номеров строк (см. sorted_order).
+ */
+class EntryTable
+{
+public:
+    using SportCode = std::uint16_t;
+
+    /**
+     * @brief Строка таблицы: ссылка на таблицу и номер строки
+     */
+    class Row
+    {
+    public:
+        Row(const EntryTable& table, std::size_t index) : table_(&table), index_(index) {}
+
+        std::string_view getName()      const { return table_->name(index_); }
+        Entry::Age       getAge()       const { return table_->ages_[index_]; }
+        Entry::Height    getHeight()    const { return table_->heights_[index_]; }
+        Entry::Weight    getWeight()    const { return table_->weights_[index_]; }
+        std::string_view getSport()     const { return table_->sport(index_); }
+        SportCode        getSportCode() const { return table_->sport_codes_[index_]; }
+        std::size_t      index()        const { return index_; }
+
+        /**
+         * @brief Собирает из строки таблицы объект класса Entry
+         */
+        Entry to_entry() const;
+
+        /**
+         * @brief Порядок тот же, что и у Entry: вид спорта, имя, возраст
+         */
+        friend bool operator<(const Row& lhs, const Row& rhs);
+
+    private:
+        const EntryTable* table_;
+        std::size_t index_;
+    };
+
+    /**
+     * @brief Итератор произвольного доступа по строкам таблицы
+     */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = Row;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = Row;
+
+        const_iterator() = default;
+        const_iterator(const EntryTable* table, std::size_t index) : table_(table), index_(index) {}
+
+        Row operator*() const { return Row(*table_, index_); }
+        Row operator[](difference_type n) const { return Row(*table_, index_ + n); }
+
+        const_iterator& operator++() { ++index_; return *this; }
+        const_iterator operator++(int) { const_iterator tmp = *this; ++index_; return tmp; }
+        const_iterator& operator--() { --index_; return *this; }
+        const_iterator operator--(int) { const_iterator tmp = *this; --index_; return tmp; }
+        const_iterator& operator+=(difference_type n) { index_ += n; return *this; }
+        const_iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+
+        friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+        friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+        friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const const_iterator& lhs, const const_iterator& rhs)
+        {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) { return lhs.index_ == rhs.index_; }
+        friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) { return lhs.index_ != rhs.index_; }
+        friend bool operator<(const const_iterator& lhs, const const_iterator& rhs) { return lhs.index_ < rhs.index_; }
+        friend bool operator>(const const_iterator& lhs, const const_iterator& rhs) { return lhs.index_ > rhs.index_; }
+        friend bool operator<=(const const_iterator& lhs, const const_iterator& rhs) { return lhs.index_ <= rhs.index_; }
+        friend bool operator>=(const const_iterator& lhs, const const_iterator& rhs) { return lhs.index_ >= rhs.index_; }
+
+    private:
+        const EntryTable* table_ = nullptr;
+        std::size_t index_ = 0;
+    };
+
+    EntryTable() = default;
+
+    /**
+     * @brief Раскладывает записи по столбцам
+     * @param[in] first, last итераторы, указывающие на диапазон объектов класса Entry
+     */
+    template<typename Iterator>
+    EntryTable(Iterator first, Iterator last)
+    {
+        reserve(static_cast<std::size_t>(std::distance(first, last)));
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    /**
+     * @brief Резервирует место под size строк
+     */
+    void reserve(std::size_t size);
+
+    /**
+     * @brief Добавляет запись в конец таблицы
+     * @param[in] entry запись
+     * @throw std::length_error, если имена не помещаются в 32-битные смещения или видов спорта
+     * больше 65536; таблица при этом не меняется
+     */
+    void push_back(const Entry& entry);
+
+    std::size_t size() const { return ages_.size(); }
+    bool empty() const { return ages_.empty(); }
+
+    Row operator[](std::size_t index) const { return Row(*this, index); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    std::string_view name(std::size_t index) const
+    {
+        return std::string_view(names_.data() + name_offsets_[index], name_offsets_[index + 1] - name_offsets_[index]);
+    }
+    std::string_view sport(std::size_t index) const { return sports_[sport_codes_[index]]; }
+
+    const std::vector<Entry::Age>&    ages()        const { return ages_; }
+    const std::vector<Entry::Height>& heights()     const { return heights_; }
+    const std::vector<Entry::Weight>& weights()     const { return weights_; }
+    const std::vector<SportCode>&     sport_codes() const { return sport_codes_; }
+
+    /**
+     * @brief Словарь видов спорта: код -- номер в векторе, в порядке первого появления
+     */
+    const std::vector<Entry::Sport>& sports() const { return sports_; }
+
+    /**
+     * @brief Возвращает номера строк в порядке, заданном компаратором
+     * @details Таблица не переставляется: сортируется вектор номеров строк, а компаратор
+     * получает строки таблицы. Полученный вектор годится для study::binary_search с
+     * извлекателем ключа вида [&table](std::uint32_t i){ return table.name(i); }.
+     * @tparam Sort функция сортировки вида sort(first, last, cmp), например study::q_sort
+     * @tparam Compare компаратор строк таблицы
+     * @param[in] sort функция сортировки
+     * @param[in] cmp компаратор
+     * @return вектор номеров строк
+     */
+    template<typename Sort, typename Compare>
+    std::vector<std::uint32_t> sorted_order(Sort sort, Compare cmp) const
+    {
+        std::vector<std::uint32_t> order(size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            order[i] = static_cast<std::uint32_t>(i);
+        sort(order.begin(), order.end(), [this, &cmp](std::uint32_t lhs, std::uint32_t rhs)
+        {
+            return cmp(Row(*this, lhs), Row(*this, rhs));
+        });
+        return order;
+    }
+
+    /**
+     * @brief Копирует первые count строк в новую таблицу (словарь видов спорта копируется целиком)
+     * @param[in] count число строк
+     */
+    EntryTable head(std::size_t count) const;
+
+    /**
+     * @brief Собирает таблицу обратно в вектор объектов класса Entry
+     */
+    std::vector<Entry> to_data() const;
+
+private:
+    std::string names_;                             //Все имена подряд
+    std::vector<std::uint32_t> name_offsets_ = {0}; //Имя строки i -- [name_offsets_[i], name_offsets_[i + 1])
+    std::vector<Entry::Age> ages_;
+    std::vector<Entry::Height> heights_;
+    std::vector<Entry::Weight> weights_;
+    std::vector<SportCode> sport_codes_;
+    std::vector<Entry::Sport> sports_;
+    std::map<Entry::Sport, SportCode, std::less<>> sport_index_;  //Поиск по std::string_view без копии строки
+};
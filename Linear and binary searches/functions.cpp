@@ -5,13 +5,27 @@
 
 #include "quick.h"
 #include "functions.h"
+#include "mapped_file.h"
 #include "my_searches.h"
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <fstream>
 #include <functional> // std::function
+#include <iterator>
+#include <limits>
 #include <map>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 
 using Data = std::vector<Entry>;
@@ -33,6 +47,20 @@ Data data_from_csv(const std::string& filename, char sep)
     return vec;
 }
 
+ArenaData arena_data_from_csv(const std::string& filename, char sep)
+{
+    MappedFile file(filename, true);
+
+    ArenaData data;
+    data.reserve(count_csv_lines(file.begin(), file.end()));
+    parse_csv_lines(file.begin(), file.end(), sep, [&data](std::string_view name, Entry::Age age, Entry::Height height,
+                                                           Entry::Weight weight, std::string_view sport)
+    {
+        data.emplace_back(name, age, height, weight, sport);
+    });
+    return data;
+}
+
 void data_to_csv(const std::string& filename, const Data& data, char sep)
 {
     std::ofstream f(filename);
@@ -45,6 +73,84 @@ void data_to_csv(const std::string& filename, const Data& data, char sep)
     f.close();
 }
 
+namespace
+{
+/**
+ * @brief Дописывает записи [first, last) в buffer в формате Entry::to_csv
+ */
+void format_csv_range(Data::const_iterator first, Data::const_iterator last, char sep, std::string& buffer)
+{
+    char digits[std::numeric_limits<int>::digits10 + 3];
+    auto append_number = [&buffer, &digits](int value)
+    {
+        const std::to_chars_result result = std::to_chars(std::begin(digits), std::end(digits), value);
+        buffer.append(digits, result.ptr);
+    };
+
+    for (; first != last; ++first)
+    {
+        buffer += first->getName();
+        buffer += sep;
+        append_number(first->getAge());
+        buffer += sep;
+        append_number(first->getHeight());
+        buffer += sep;
+        append_number(first->getWeight());
+        buffer += sep;
+        buffer += first->getSport();
+        buffer += '\n';
+    }
+}
+} // namespace
+
+void data_to_csv_buffered(const std::string& filename, const Data& data, std::size_t thread_count, char sep)
+{
+    std::ofstream f(filename, std::ios::binary);
+    if (!f.is_open()) throw std::runtime_error("Cannot open output csv-file");
+    if (thread_count == 0)
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+    // За один круг каждый поток форматирует в свой буфер кусок из chunk_rows записей,
+    // затем буферы записываются в файл по порядку. Буферы переиспользуются между кругами,
+    // поэтому память ограничена thread_count кусками, а не размером данных
+    constexpr std::size_t chunk_rows = 1 << 14;
+    std::vector<std::string> buffers(thread_count);
+    std::vector<std::exception_ptr> errors(thread_count);
+    std::vector<std::thread> threads;
+    for (std::size_t round_first = 0; round_first < data.size(); round_first += chunk_rows * thread_count)
+    {
+        auto format = [&data, &buffers, &errors, round_first, sep](std::size_t t)
+        {
+            try
+            {
+                const std::size_t first = std::min(data.size(), round_first + t * chunk_rows);
+                const std::size_t last = std::min(data.size(), first + chunk_rows);
+                buffers[t].clear();
+                format_csv_range(data.begin() + static_cast<std::ptrdiff_t>(first),
+                                 data.begin() + static_cast<std::ptrdiff_t>(last), sep, buffers[t]);
+            }
+            catch (...)
+            {
+                errors[t] = std::current_exception();
+            }
+        };
+
+        threads.clear();
+        for (std::size_t t = 1; t < thread_count && round_first + t * chunk_rows < data.size(); ++t)
+            threads.emplace_back(format, t);
+        format(0);
+        for (std::thread& thread : threads)
+            thread.join();
+        for (const std::exception_ptr& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+
+        for (std::size_t t = 0; t <= threads.size(); ++t)
+            f.write(buffers[t].data(), static_cast<std::streamsize>(buffers[t].size()));
+    }
+    if (!f) throw std::runtime_error("Cannot write output csv-file");
+}
+
 void times_to_csv(const std::string& filename, const std::vector<my_tuple>& statistics, char sep)
 {
     std::ofstream f(filename);
@@ -66,11 +172,32 @@ Data get_slice_of_data(const Data& data, const std::size_t& size)
     return part_data;
 }
 
+namespace
+{
+/**
+ * @brief Число элементов, найденных последним замеренным поиском
+ * @details Запись результата в volatile не дает оптимизатору выбросить замеряемый поиск
+ */
+volatile std::size_t found_sink = 0;
+
+template <typename Iterator>
+void keep_found(const std::vector<Iterator>& found)
+{
+    found_sink = found.size();
+}
+
+template <typename Iterator>
+void keep_found(const std::pair<Iterator, Iterator>& found)
+{
+    found_sink = static_cast<std::size_t>(std::distance(found.first, found.second));
+}
+} // namespace
+
 std::uint64_t get_time_lin_search(const Entry::Name& key, const Data& data, const std::size_t& size)
 {
     Data::const_iterator data_size = std::next(data.begin(), static_cast<std::ptrdiff_t>(size));
     std::chrono::time_point<Clock> start = Clock::now();
-    auto _ = study::linear_search(data.begin(), data_size, key, [](const Entry& lhs, const Entry::Name& rhs){return lhs.getName() == rhs;});
+    keep_found(study::linear_search(data.begin(), data_size, key, [](const Entry& lhs, const Entry::Name& rhs){return lhs.getName() == rhs;}));
     std::chrono::time_point<Clock> end = Clock::now();
 
     return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
@@ -82,27 +209,153 @@ std::uint64_t get_time_bin_search(const Entry::Name& key, const Data& data,
     std::chrono::time_point<Clock> start;
     std::chrono::time_point<Clock> end;
     Data part_data = get_slice_of_data(data, size);
+    auto by_name = [](const Entry& lhs, const Entry& rhs) { return lhs.getName() < rhs.getName(); };
+
+    if (time_before_sort)
+    {
+        start = Clock::now();
+        study::q_sort(part_data.begin(), part_data.end(), by_name);
+    }
+    else
+    {
+        study::q_sort(part_data.begin(), part_data.end(), by_name);
+        start = Clock::now();
+    }
+    keep_found(study::binary_search(part_data.begin(),
+                           part_data.end(), key,
+                           [](const std::string& lhs, const std::string& rhs) {return lhs < rhs;},
+                           [](const Entry& elem) -> const Entry::Name& {return elem.getName();}));
+    end = Clock::now();
+
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+std::uint64_t get_time_lin_search(const Entry::Name& key, const EntryTable& table, const std::size_t& size)
+{
+    EntryTable::const_iterator table_size = std::next(table.begin(), static_cast<std::ptrdiff_t>(size));
+    const std::string_view name = key;
+    std::chrono::time_point<Clock> start = Clock::now();
+    keep_found(study::linear_search(table.begin(), table_size, name,
+                                    [](const EntryTable::Row& lhs, std::string_view rhs){return lhs.getName() == rhs;}));
+    std::chrono::time_point<Clock> end = Clock::now();
+
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+std::uint64_t get_time_bin_search(const Entry::Name& key, const EntryTable& table,
+                                  const std::size_t& size, bool time_before_sort)
+{
+    std::chrono::time_point<Clock> start;
+    std::chrono::time_point<Clock> end;
+    EntryTable part_table = table.head(size);
+    auto sort = [](auto first, auto last, auto cmp) { study::q_sort(first, last, cmp); };
+    auto by_name = [](const EntryTable::Row& lhs, const EntryTable::Row& rhs) { return lhs.getName() < rhs.getName(); };
+    std::vector<std::uint32_t> order;
 
     if (time_before_sort)
     {
         start = Clock::now();
-        study::q_sort(part_data.begin(), part_data.end());
+        order = part_table.sorted_order(sort, by_name);
+    }
+    else
+    {
+        order = part_table.sorted_order(sort, by_name);
+        start = Clock::now();
+    }
+    const std::string_view name = key;
+    keep_found(study::binary_search(order.begin(), order.end(), name,
+                                    [](std::string_view lhs, std::string_view rhs) {return lhs < rhs;},
+                                    [&part_table](std::uint32_t i) {return part_table.name(i);}));
+    end = Clock::now();
+
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+std::uint64_t get_time_lin_search(const Entry::Name& key, const ArenaData& data, const std::size_t& size)
+{
+    ArenaData::const_iterator data_size = std::next(data.begin(), static_cast<std::ptrdiff_t>(size));
+    const std::string_view name = key;
+    std::chrono::time_point<Clock> start = Clock::now();
+    keep_found(study::linear_search(data.begin(), data_size, name,
+                                    [](const ArenaEntry& lhs, std::string_view rhs){return lhs.getName() == rhs;}));
+    std::chrono::time_point<Clock> end = Clock::now();
+
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+std::uint64_t get_time_bin_search(const Entry::Name& key, const ArenaData& data,
+                                  const std::size_t& size, bool time_before_sort)
+{
+    std::chrono::time_point<Clock> start;
+    std::chrono::time_point<Clock> end;
+    // Копируются только записи; строки остаются в арене data
+    std::vector<ArenaEntry> part_data(data.begin(), std::next(data.begin(), static_cast<std::ptrdiff_t>(size)));
+    auto by_name = [](const ArenaEntry& lhs, const ArenaEntry& rhs) { return lhs.getName() < rhs.getName(); };
 
+    if (time_before_sort)
+    {
+        start = Clock::now();
+        study::q_sort(part_data.begin(), part_data.end(), by_name);
     }
     else
     {
-        study::q_sort(part_data.begin(), part_data.end());
+        study::q_sort(part_data.begin(), part_data.end(), by_name);
         start = Clock::now();
     }
-    auto _ = study::binary_search(part_data.begin(),
-                         part_data.end(), key,
-                         [](const std::string& lhs, const std::string& rhs) {return lhs < rhs;},
-                         [](const Entry& elem) {return elem.getName();});
+    const std::string_view name = key;
+    keep_found(study::binary_search(part_data.begin(),
+                           part_data.end(), name,
+                           [](std::string_view lhs, std::string_view rhs) {return lhs < rhs;},
+                           [](const ArenaEntry& elem) {return elem.getName();}));
     end = Clock::now();
 
     return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
 }
 
+std::pair<std::uint64_t, std::uint64_t> get_load_footprint(const std::function<void()>& load)
+{
+    int fds[2];
+    if (::pipe(fds) != 0)
+        throw std::runtime_error("Cannot create pipe");
+
+    const pid_t pid = ::fork();
+    if (pid < 0)
+    {
+        ::close(fds[0]);
+        ::close(fds[1]);
+        throw std::runtime_error("Cannot fork");
+    }
+    if (pid == 0)
+    {
+        // Дочерний процесс: загружает данные и пишет в канал время и прирост пикового RSS
+        ::close(fds[0]);
+        struct rusage usage;
+        ::getrusage(RUSAGE_SELF, &usage);
+        const long rss_before = usage.ru_maxrss;
+
+        std::chrono::time_point<Clock> start = Clock::now();
+        load();
+        std::chrono::time_point<Clock> end = Clock::now();
+
+        ::getrusage(RUSAGE_SELF, &usage);
+        const std::uint64_t result[2] = {
+            static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()),
+            static_cast<std::uint64_t>(usage.ru_maxrss - rss_before)};
+        const bool written = ::write(fds[1], result, sizeof(result)) == static_cast<ssize_t>(sizeof(result));
+        ::_exit(written ? 0 : 1);
+    }
+
+    ::close(fds[1]);
+    std::uint64_t result[2] = {0, 0};
+    const bool read_ok = ::read(fds[0], result, sizeof(result)) == static_cast<ssize_t>(sizeof(result));
+    ::close(fds[0]);
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    if (!read_ok || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        throw std::runtime_error("Loading in child process failed");
+    return {result[0], result[1]};
+}
+
 std::uint64_t get_time_mmap_search(const Entry::Name& key, const Data& data,
                                    const std::size_t& size)
 {
@@ -110,7 +363,7 @@ std::uint64_t get_time_mmap_search(const Entry::Name& key, const Data& data,
     mmap_name_entry mmap_Entry = data_to_map(part_data);
 
     std::chrono::time_point<Clock> start = Clock::now();
-    auto _ = mmap_Entry.equal_range(key);
+    keep_found(mmap_Entry.equal_range(key));
     std::chrono::time_point<Clock> end = Clock::now();
 
     return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
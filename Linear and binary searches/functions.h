@@ -5,9 +5,13 @@
 
 #pragma once
 
+#include "arena_data.h"
 #include "entry.h"
+#include "entry_io.h"
+#include "entry_table.h"
 #include <functional>
 #include <map>
+#include <utility>
 #include <vector>
 
 using Data = std::vector<Entry>;
@@ -22,6 +26,15 @@ using mmap_name_entry = std::multimap<Entry::Name, Entry>;
  */
 Data data_from_csv(const std::string& filename, char sep=',');
 
+/**
+ * @brief Считывает данные из csv-файла так же, как data_from_csv_mmap, но в ArenaData:
+ * строки записей копируются в арену набора, а не в отдельные std::string
+ * @param[in] filename имя/путь к файлу с данными для чтения
+ * @param[in] sep использующийся в csv-файле разделитель
+ * @return набор ArenaData, определенный в "arena_data.h"
+ */
+ArenaData arena_data_from_csv(const std::string& filename, char sep=',');
+
 /**
  * @brief Записывает данные типа std::vector<Entry> в формате csv в файл
  * @param[out] filename файл, в который будут записаны данные
@@ -30,6 +43,19 @@ Data data_from_csv(const std::string& filename, char sep=',');
  */
 void data_to_csv(const std::string& filename, const Data& data, char sep=',');
 
+/**
+ * @brief Записывает данные в csv-файл так же, как data_to_csv, но быстрее: записи
+ * форматируются std::to_chars в большие переиспользуемые буферы, которые выводятся
+ * несколькими крупными вызовами write
+ * @param[out] filename файл, в который будут записаны данные
+ * @param[in] data данные для записи в файл
+ * @param[in] thread_count число потоков, форматирующих куски данных; 0 -- по числу ядер
+ * @param[in] sep разделитель для csv-файла
+ * @throw std::runtime_error, если файл не удалось открыть или записать; исключение потока,
+ * форматирующего кусок (например, std::bad_alloc), передается вызывающему после join
+ */
+void data_to_csv_buffered(const std::string& filename, const Data& data, std::size_t thread_count=1, char sep=',');
+
 /**
  * @brief Измеряет время работы линейного поиска
  * @param[in] key ключ, по которому производится поиск
@@ -40,7 +66,8 @@ void data_to_csv(const std::string& filename, const Data& data, char sep=',');
 std::uint64_t get_time_lin_search(const Entry::Name& key, const Data& data, const std::size_t& size);
 
 /**
- * @brief Измеряет время работы бинарного поиска
+ * @brief Измеряет время работы бинарного поиска; записи сортируются по имени,
+ * как в вариантах для EntryTable и ArenaData
  * @param[in] key ключ, по которому производится поиск
  * @param[in] data данные, в которых будет производиться поиск
  * @param[in] size количество строк, в которых будет производиться поиск
@@ -50,6 +77,58 @@ std::uint64_t get_time_lin_search(const Entry::Name& key, const Data& data, cons
 std::uint64_t get_time_bin_search(const Entry::Name& key, const Data& data,
                                   const std::size_t& size, bool time_before_sort=false);
 
+/**
+ * @brief Измеряет время работы линейного поиска по столбцу имен таблицы EntryTable
+ * @param[in] key ключ, по которому производится поиск
+ * @param[in] table данные, в которых будет производиться поиск
+ * @param[in] size количество строк, в которых будет производиться поиск
+ * @return число типа std::uint64_t -- время, затраченное на поиск
+ */
+std::uint64_t get_time_lin_search(const Entry::Name& key, const EntryTable& table, const std::size_t& size);
+
+/**
+ * @brief Измеряет время работы бинарного поиска по таблице EntryTable
+ * @details Сортируется вектор номеров строк по имени (study::q_sort), затем
+ * study::binary_search ищет по нему с извлечением имени из столбца.
+ * @param[in] key ключ, по которому производится поиск
+ * @param[in] table данные, в которых будет производиться поиск
+ * @param[in] size количество строк, в которых будет производиться поиск
+ * @param[in] time_before_sort начинать отсчет времени до сортировки (true) или после (false)
+ * @return число типа std::uint64_t -- время, затраченное на поиск или сортировку + поиск
+ */
+std::uint64_t get_time_bin_search(const Entry::Name& key, const EntryTable& table,
+                                  const std::size_t& size, bool time_before_sort=false);
+
+/**
+ * @brief Измеряет время работы линейного поиска по набору ArenaData
+ * @param[in] key ключ, по которому производится поиск
+ * @param[in] data данные, в которых будет производиться поиск
+ * @param[in] size количество строк, в которых будет производиться поиск
+ * @return число типа std::uint64_t -- время, затраченное на поиск
+ */
+std::uint64_t get_time_lin_search(const Entry::Name& key, const ArenaData& data, const std::size_t& size);
+
+/**
+ * @brief Измеряет время работы бинарного поиска по набору ArenaData; записи сортируются по имени,
+ * как в вариантах для Data и EntryTable
+ * @param[in] key ключ, по которому производится поиск
+ * @param[in] data данные, в которых будет производиться поиск
+ * @param[in] size количество строк, в которых будет производиться поиск
+ * @param[in] time_before_sort начинать отсчет времени до сортировки (true) или после (false)
+ * @return число типа std::uint64_t -- время, затраченное на поиск или сортировку + поиск
+ */
+std::uint64_t get_time_bin_search(const Entry::Name& key, const ArenaData& data,
+                                  const std::size_t& size, bool time_before_sort=false);
+
+/**
+ * @brief Измеряет время загрузки данных и прирост пикового объема резидентной памяти (RSS)
+ * @details Загрузка выполняется в дочернем процессе (POSIX fork), чтобы пиковый RSS
+ * не зависел от предыдущих замеров.
+ * @param[in] load функция, загружающая данные
+ * @return пара (время в микросекундах, прирост пикового RSS в килобайтах)
+ */
+std::pair<std::uint64_t, std::uint64_t> get_load_footprint(const std::function<void()>& load);
+
 /**
  * Копирует часть данных и возвращает в виде вектора объектов класса Entry
  * @param[in] data входной набор данных
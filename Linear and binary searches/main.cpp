@@ -1,5 +1,6 @@
 #include "functions.h"
 #include "my_searches.h"
+#include <functional>
 #include <iostream>
 #include <map>
 #include <numeric> //for std::accumulate
@@ -25,8 +26,32 @@ int main()
         return 1;
     }
 
+    // Время загрузки и пиковый RSS: std::string в каждой записи против арены.
+    // Замеряется до загрузки основных данных, пока куча процесса почти пуста
+    std::vector<std::pair<std::string, std::uint64_t>> load_statistics;
+    std::vector<std::pair<std::string, std::function<void()>>> loaders = {
+        {"Entry (getline)", [&filename]() { Data loaded = data_from_csv(filename); }},
+        {"Entry (mmap)", [&filename]() { Data loaded = data_from_csv_mmap(filename); }},
+        {"Arena (mmap)", [&filename]() { ArenaData loaded = arena_data_from_csv(filename); }}};
+    for (const auto& [loader_name, load] : loaders)
+    {
+        std::cout << "Loading " << loader_name << "... " << std::flush;
+        const auto [load_time, peak_rss] = get_load_footprint(load);
+        load_statistics.emplace_back("Load time (us): " + loader_name, load_time);
+        load_statistics.emplace_back("Peak RSS (KB): " + loader_name, peak_rss);
+        std::cout << "Done.\n";
+    }
+
     Data data = data_from_csv(filename);
 
+    std::vector<my_tuple> footprint_statistics;
+    for (const auto& [act, value] : load_statistics)
+        footprint_statistics.emplace_back(data.size(), act, value);
+    times_to_csv("load_footprint.csv", footprint_statistics);
+
+    EntryTable table(data.begin(), data.end());
+    ArenaData arena_data = arena_data_from_csv(filename);
+
     std::vector<std::size_t> sizes =
     {100, 200, 400, 600, 800, 1000, 1500, 2000, 3000, 4000, 5500, 8000, 11000, 15000, 20000, 30000, 40000, 50000, 70000, 100000};
 
@@ -82,6 +107,61 @@ int main()
         time.clear();
         std::cout << "Done.\n";
 
+        act = "Linear search (columnar)";
+        std::cout << "Running " << act << "... " << std::flush;
+        for (const std::string& name : names)
+        {
+           time.push_back(get_time_lin_search(name, table, size));
+        }
+        time_mean = static_cast<std::uint64_t>(std::accumulate(time.begin(), time.end(), 0.0/time.size()));
+        statistics.emplace_back(size, act, time_mean);
+        time.clear();
+        std::cout << "Done.\n";
+
+        act = "Binary search (columnar, presorted)";
+        std::cout << "Running " << act << "... " << std::flush;
+        for (const std::string& name : names)
+        {
+           time.push_back(get_time_bin_search(name, table, size));
+        }
+        time_mean = static_cast<std::uint64_t>(std::accumulate(time.begin(), time.end(), 0.0/time.size()));
+        statistics.emplace_back(size, act, time_mean);
+        time.clear();
+        std::cout << "Done.\n";
+
+        act = "Binary search (columnar, with sort)";
+        std::cout << "Running " << act << "... " << std::flush;
+        for (const std::string& name : names)
+        {
+           time.push_back(get_time_bin_search(name, table, size, true));
+        }
+        time_mean = static_cast<std::uint64_t>(std::accumulate(time.begin(), time.end(), 0.0/time.size()));
+        statistics.emplace_back(size, act, time_mean);
+        time.clear();
+        std::cout << "Done.\n";
+
+        act = "Linear search (arena)";
+        std::cout << "Running " << act << "... " << std::flush;
+        for (const std::string& name : names)
+        {
+           time.push_back(get_time_lin_search(name, arena_data, size));
+        }
+        time_mean = static_cast<std::uint64_t>(std::accumulate(time.begin(), time.end(), 0.0/time.size()));
+        statistics.emplace_back(size, act, time_mean);
+        time.clear();
+        std::cout << "Done.\n";
+
+        act = "Binary search (arena, presorted)";
+        std::cout << "Running " << act << "... " << std::flush;
+        for (const std::string& name : names)
+        {
+           time.push_back(get_time_bin_search(name, arena_data, size));
+        }
+        time_mean = static_cast<std::uint64_t>(std::accumulate(time.begin(), time.end(), 0.0/time.size()));
+        statistics.emplace_back(size, act, time_mean);
+        time.clear();
+        std::cout << "Done.\n";
+
         act = "Multimap search";
         std::cout << "Running " << act << "... " << std::flush;
         for (const std::string& name : names)
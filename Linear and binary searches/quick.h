@@ -1,16 +1,132 @@
 /**
  * @file
  * @brief Файл, содержащий реализацию быстрой сортировки(quick sort).
- * @details Some loooong details.
+ * @details Гибридная сортировка (introsort): опорный элемент -- медиана трех
+ * (на больших диапазонах -- медиана трех медиан), рекурсия только в меньшую часть,
+ * короткие диапазоны досортировываются вставками, а при слишком глубокой рекурсии
+ * диапазон сортируется пирамидальной сортировкой. Время O(n log n) в худшем случае,
+ * глубина стека O(log n).
  */
 
 #pragma once
 
+#include "heap.h"
+#include "insertions.h"
 #include <cstdlib>
 #include <iterator>
+#include <stdexcept>
 
 namespace study
 {
+    /**
+     * Диапазоны не длиннее этого сортируются вставками
+     */
+    constexpr std::ptrdiff_t q_sort_insertion_threshold = 16;
+
+    /**
+     * Диапазоны длиннее этого выбирают опорный элемент как медиану трех медиан
+     */
+    constexpr std::ptrdiff_t q_sort_ninther_threshold = 128;
+
+    /**
+     * Вспомогательная функция: ставит медиану *a, *b, *c на место a
+     * @param[in,out] a, b, c итераторы на три элемента
+     * @param[in] cmp компаратор, проверяющий, должен ли его первый аргумент стоять левее второго
+     */
+    template<typename Iterator, typename Compare>
+    void median_to_first(Iterator a, Iterator b, Iterator c, Compare cmp)
+    {
+        if (cmp(*b, *a))
+            std::iter_swap(a, b);
+        if (cmp(*c, *b))
+        {
+            std::iter_swap(b, c);
+            if (cmp(*b, *a))
+                std::iter_swap(a, b);
+        }
+        // Теперь *a <= *b <= *c
+        std::iter_swap(a, b);
+    }
+
+    /**
+     * Вспомогательная функция: выбирает опорный элемент, ставит его в начало диапазона
+     * и разбивает диапазон
+     * @details После выбора опорного элемента правее него есть элементы и не меньше,
+     * и не больше его, поэтому внутренние циклы разбиения не проверяют границы.
+     * Элементы, равные опорному, останавливают оба цикла, поэтому диапазоны
+     * с повторами делятся пополам.
+     * @param[in,out] first, last итераторы, указывающие на диапазон из не менее чем трех элементов
+     * @param[in] cmp компаратор, проверяющий, должен ли его первый аргумент стоять левее второго
+     * @return итератор cut: элементы [first, cut) не больше элементов [cut, last), оба диапазона непусты
+     */
+    template<typename Iterator, typename Compare>
+    Iterator q_sort_partition(Iterator first, Iterator last, Compare cmp)
+    {
+        using diff_t = typename std::iterator_traits<Iterator>::difference_type;
+        const diff_t size = std::distance(first, last);
+        Iterator mid = std::next(first, size / 2);
+        Iterator back = std::prev(last);
+        if (size > q_sort_ninther_threshold)
+        {
+            const diff_t step = size / 8;
+            median_to_first(std::next(first, 1), std::next(first, 1 + step), std::next(first, 1 + 2 * step), cmp);
+            median_to_first(mid, std::prev(mid, step), std::next(mid, step), cmp);
+            median_to_first(back, std::prev(back, step), std::prev(back, 2 * step), cmp);
+        }
+        std::iter_swap(first, mid);
+        median_to_first(first, std::next(first), back, cmp);
+
+        Iterator left  = std::next(first);
+        Iterator right = last;
+        while (true)
+        {
+            while (cmp(*left, *first))
+                ++left;     // find elem from left not less than pivot
+            --right;
+            while (cmp(*first, *right))
+                --right;    // find elem from right not bigger than pivot
+            if (!(left < right))
+                return left;
+            std::iter_swap(left, right);
+            ++left;
+        }
+    }
+
+    /**
+     * Вспомогательная функция быстрой сортировки с ограничением глубины рекурсии
+     * @param[in,out] first, last итераторы, указывающие на диапазон, который нужно отсортировать
+     * @param[in] depth_limit сколько еще разбиений допустимо до перехода на пирамидальную сортировку
+     * @param[in] cmp компаратор, проверяющий, должен ли его первый аргумент стоять левее второго
+     */
+    template<typename Iterator, typename Compare>
+    void q_sort_loop(Iterator first, Iterator last, int depth_limit, Compare cmp)
+    {
+        while (std::distance(first, last) > q_sort_insertion_threshold)
+        {
+            if (depth_limit == 0)
+            {
+                heap_sort(first, last, cmp);
+                return;
+            }
+            --depth_limit;
+
+            Iterator cut = q_sort_partition(first, last, cmp);
+            // recursion for the smaller part, loop for the bigger one
+            if (std::distance(first, cut) < std::distance(cut, last))
+            {
+                q_sort_loop(first, cut, depth_limit, cmp);
+                first = cut;
+            }
+            else
+            {
+                q_sort_loop(cut, last, depth_limit, cmp);
+                last = cut;
+            }
+        }
+        if (first != last)
+            insertions_sort(first, last, cmp);
+    }
+
     /**
      * Реализует быструю сортировку диапазона элементов
      * @tparam Iterator
@@ -21,32 +137,14 @@ namespace study
      template< typename Iterator, typename Compare >
      void q_sort(Iterator first, Iterator last, Compare cmp)
      {
-       if (first > last) throw std::runtime_error("Begin iterator is bigger than end.");\
-
-       if(first != last)
-       {
-         Iterator left  = std::next(first);
-         Iterator right = last;
-
-         while(left != right)
-         {
-           if(cmp(*left, *first))
-           {
-              ++left;   // find elem from left bigger than first
-           }
-           else
-           {
-              while ((left != --right) && cmp(*first, *right)); // find elem from right less than first
-              std::iter_swap(left, right);  // and swap it with left
-           }
-         }
-         --left;    // get prev left to make it before right
-         std::iter_swap(first, left);
-
-         // recursion for 2 parts of sequency
-         q_sort(first, left, cmp);
-         q_sort(right, last, cmp);
-       }
+       if (first > last) throw std::runtime_error("Begin iterator is bigger than end.");
+
+       // depth limit is 2 * log2(size)
+       int depth_limit = 0;
+       for (auto size = std::distance(first, last); size > 1; size >>= 1)
+         depth_limit += 2;
+
+       q_sort_loop(first, last, depth_limit, cmp);
      }
 
     /**
@@ -13,6 +13,16 @@
 #include <tuple>    // tie -- for creating tuples of lvalue references
 
 bool operator<(const Entry& lhs, const Entry& rhs)
+{
+    // Порядок кодов одного словаря совпадает с порядком строк, а разные виды спорта имеют
+    // разные коды, поэтому строки видов спорта сравниваются, только если коды несравнимы
+    if (SportDictionary::comparable(lhs.sport_code_, rhs.sport_code_))
+        return std::tie(lhs.sport_code_, lhs.name_, lhs.age_) <
+               std::tie(rhs.sport_code_, rhs.name_, rhs.age_);
+    return sport_string_less(lhs, rhs);
+}
+
+bool sport_string_less(const Entry& lhs, const Entry& rhs)
 {
     // tie is for making temporary tuples of references
     return std::tie(lhs.sport_, lhs.name_, lhs.age_) <
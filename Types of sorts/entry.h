@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "sport_dictionary.h"
 #include<iostream>
 #include <utility> // for std::move - flag that object may be "moved from"
 
@@ -32,11 +33,17 @@ public:
         , sport_(std::move(sport))
     {}
 
-    Name    getName()   const { return name_; }
-    Age     getAge()    const { return age_; }
-    Height  getHeight() const { return height_; }
-    Weight  getWeight() const { return weight_; }
-    Sport   getSport()  const { return sport_; }
+    const Name&  getName()   const { return name_; }
+    Age          getAge()    const { return age_; }
+    Height       getHeight() const { return height_; }
+    Weight       getWeight() const { return weight_; }
+    const Sport& getSport()  const { return sport_; }
+
+    /**
+     * @brief Код вида спорта, назначенный SportDictionary::encode; SportDictionary::no_code, если кода нет
+     */
+    SportDictionary::Code getSportCode() const { return sport_code_; }
+    void setSportCode(SportDictionary::Code code) { sport_code_ = code; }
 
     /**
      * @brief Выводит члены класса в заданный поток вывода в формате csv с заданным разделителем
@@ -52,6 +59,7 @@ public:
     friend bool operator<=(const Entry& lhs, const Entry& rhs);
     friend bool operator>=(const Entry& lhs, const Entry& rhs);
     friend std::ostream& operator<<(std::ostream& stream, const Entry& entry);
+    friend bool sport_string_less(const Entry& lhs, const Entry& rhs);
 
 private:
     Name name_;
@@ -59,8 +67,15 @@ private:
     Height height_;
     Weight weight_;
     Sport sport_;
+    SportDictionary::Code sport_code_ = SportDictionary::no_code;
 };
 
+/**
+ * @brief Тот же порядок, что и у operator<, но вид спорта всегда сравнивается как строка,
+ * без кодов из SportDictionary (для сравнения скорости)
+ */
+bool sport_string_less(const Entry& lhs, const Entry& rhs);
+
 /**
  * @brief Считывает строку из csv и создает объект класса Entry
  * @param[in] line строка csv-файла
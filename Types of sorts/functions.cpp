@@ -5,11 +5,18 @@
 
 #include "sorts.h"
 #include "functions.h"
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <fstream>
 #include <functional> // std::function
+#include <limits>
 #include <map>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 using Data = std::vector<Entry>;
@@ -42,6 +49,84 @@ void data_to_csv(const std::string& filename, const Data& data, char sep)
     f.close();
 }
 
+namespace
+{
+/**
+ * @brief Дописывает записи [first, last) в buffer в формате Entry::to_csv
+ */
+void format_csv_range(Data::const_iterator first, Data::const_iterator last, char sep, std::string& buffer)
+{
+    char digits[std::numeric_limits<int>::digits10 + 3];
+    auto append_number = [&buffer, &digits](int value)
+    {
+        const std::to_chars_result result = std::to_chars(std::begin(digits), std::end(digits), value);
+        buffer.append(digits, result.ptr);
+    };
+
+    for (; first != last; ++first)
+    {
+        buffer += first->getName();
+        buffer += sep;
+        append_number(first->getAge());
+        buffer += sep;
+        append_number(first->getHeight());
+        buffer += sep;
+        append_number(first->getWeight());
+        buffer += sep;
+        buffer += first->getSport();
+        buffer += '\n';
+    }
+}
+} // namespace
+
+void data_to_csv_buffered(const std::string& filename, const Data& data, std::size_t thread_count, char sep)
+{
+    std::ofstream f(filename, std::ios::binary);
+    if (!f.is_open()) throw std::runtime_error("Cannot open output csv-file");
+    if (thread_count == 0)
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+    // За один круг каждый поток форматирует в свой буфер кусок из chunk_rows записей,
+    // затем буферы записываются в файл по порядку. Буферы переиспользуются между кругами,
+    // поэтому память ограничена thread_count кусками, а не размером данных
+    constexpr std::size_t chunk_rows = 1 << 14;
+    std::vector<std::string> buffers(thread_count);
+    std::vector<std::exception_ptr> errors(thread_count);
+    std::vector<std::thread> threads;
+    for (std::size_t round_first = 0; round_first < data.size(); round_first += chunk_rows * thread_count)
+    {
+        auto format = [&data, &buffers, &errors, round_first, sep](std::size_t t)
+        {
+            try
+            {
+                const std::size_t first = std::min(data.size(), round_first + t * chunk_rows);
+                const std::size_t last = std::min(data.size(), first + chunk_rows);
+                buffers[t].clear();
+                format_csv_range(data.begin() + static_cast<std::ptrdiff_t>(first),
+                                 data.begin() + static_cast<std::ptrdiff_t>(last), sep, buffers[t]);
+            }
+            catch (...)
+            {
+                errors[t] = std::current_exception();
+            }
+        };
+
+        threads.clear();
+        for (std::size_t t = 1; t < thread_count && round_first + t * chunk_rows < data.size(); ++t)
+            threads.emplace_back(format, t);
+        format(0);
+        for (std::thread& thread : threads)
+            thread.join();
+        for (const std::exception_ptr& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+
+        for (std::size_t t = 0; t <= threads.size(); ++t)
+            f.write(buffers[t].data(), static_cast<std::streamsize>(buffers[t].size()));
+    }
+    if (!f) throw std::runtime_error("Cannot write output csv-file");
+}
+
 void times_to_csv(const std::string& filename, const std::vector<my_tuple>& statistics, char sep)
 {
     std::ofstream f(filename);
@@ -76,6 +161,15 @@ std::uint64_t get_time_sort(const std::function<void(Data::iterator, Data::itera
     return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
 }
 
+std::uint64_t get_time_write(const std::function<void(const std::string&, const Data&)>& write_function,
+                             const std::string& filename, const Data& data)
+{
+    std::chrono::time_point<Clock> start = Clock::now();
+    write_function(filename, data);
+    std::chrono::time_point<Clock> end = Clock::now();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+}
+
 std::string get_file_ext(const std::string& filename)
 {
     size_t i = filename.rfind('.', filename.length());
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "entry.h"
+#include "entry_io.h"
 #include <functional>
 #include <vector>
 
@@ -28,6 +29,29 @@ Data data_from_csv(const std::string& filename, char sep=',');
  */
 void data_to_csv(const std::string& filename, const Data& data, char sep=',');
 
+/**
+ * @brief Записывает данные в csv-файл так же, как data_to_csv, но быстрее: записи
+ * форматируются std::to_chars в большие переиспользуемые буферы, которые выводятся
+ * несколькими крупными вызовами write
+ * @param[out] filename файл, в который будут записаны данные
+ * @param[in] data данные для записи в файл
+ * @param[in] thread_count число потоков, форматирующих куски данных; 0 -- по числу ядер
+ * @param[in] sep разделитель для csv-файла
+ * @throw std::runtime_error, если файл не удалось открыть или записать; исключение потока,
+ * форматирующего кусок (например, std::bad_alloc), передается вызывающему после join
+ */
+void data_to_csv_buffered(const std::string& filename, const Data& data, std::size_t thread_count=1, char sep=',');
+
+/**
+ * @brief Измеряет время записи данных в csv-файл
+ * @param[in] write_function функция записи, принимающая имя файла и данные
+ * @param[in] filename файл, в который будут записаны данные
+ * @param[in] data данные для записи
+ * @return число типа std::uint64_t -- время записи в микросекундах
+ */
+std::uint64_t get_time_write(const std::function<void(const std::string&, const Data&)>& write_function,
+                             const std::string& filename, const Data& data);
+
 /**
  * @brief Измеряет время работы функции сортровки из пространства имен Study
  * @param[in] sort_function используемая функция
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <iterator>
+#include <stdexcept>
 
 /**
  * @namespace study
@@ -68,8 +69,8 @@ namespace study
     template<typename Iterator, typename Compare>
     void build_heap(Iterator begin, typename std::iterator_traits<Iterator>::difference_type heap_size, Compare cmp)
     {
-        for (Iterator i = std::next(begin, heap_size / 2); i != std::prev(begin); --i)
-            sift_down(begin, i, heap_size, cmp);
+        for (auto i = heap_size / 2; i >= 0; --i)
+            sift_down(begin, std::next(begin, i), heap_size, cmp);
     }
 
     /**
@@ -8,6 +8,7 @@
 
 #include <cstdlib>
 #include <iterator>
+#include <stdexcept>
 
 namespace study
 {
@@ -32,7 +33,9 @@ namespace study
              cur_elem = tmp;
              while (cur_elem != first && cmp(*cur_elem, *std::prev(cur_elem)))
              {
-                 std::iter_swap(cur_elem, --cur_elem);
+                 BiDirIterator prev_elem = std::prev(cur_elem);
+                 std::iter_swap(cur_elem, prev_elem);
+                 cur_elem = prev_elem;
              }
           }
     }
@@ -11,8 +11,11 @@
 
 #include "entry.h"
 #include "functions.h"
+#include "sort_key.h"
 #include "sorts.h"
+#include <algorithm>
 #include <filesystem>
+#include <functional>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -35,6 +38,8 @@ int main()
     }
 
     Data data = data_from_csv(filename);
+    SportDictionary sports;
+    sports.encode(data.begin(), data.end());
 //    data_to_csv("test.csv", data, ',');
 
     std::vector<std::size_t> sizes =
@@ -70,4 +75,154 @@ int main()
 
     //times_to_csv("times.csv", statistics);
 
+    // Сравнение кодов видов спорта из SportDictionary со сравнением строк
+    std::vector<my_tuple> sport_statistics;
+    auto q_sort_strings = [](Data::iterator first, Data::iterator last)
+    {
+        study::q_sort(first, last, sport_string_less);
+    };
+    auto heap_sort_strings = [](Data::iterator first, Data::iterator last)
+    {
+        study::heap_sort(first, last, sport_string_less);
+    };
+
+    for (std::size_t size : sizes)
+    {
+        std::cout << "-----Size: " << size << "------\n";
+
+        std::string str_sort = "QuickSort (sport codes)";
+        std::cout << "Running " << str_sort << "..." << std::flush;
+        time = get_time_sort(study::q_sort<Data::iterator>, data, size);
+        sport_statistics.emplace_back(std::make_tuple(size, str_sort, time));
+        std::cout << "Done.\n";
+
+        str_sort = "QuickSort (sport strings)";
+        std::cout << "Running " << str_sort << "..." << std::flush;
+        time = get_time_sort(q_sort_strings, data, size);
+        sport_statistics.emplace_back(std::make_tuple(size, str_sort, time));
+        std::cout << "Done.\n";
+
+        str_sort = "HeapSort (sport codes)";
+        std::cout << "Running " << str_sort << "..." << std::flush;
+        time = get_time_sort(study::heap_sort<Data::iterator>, data, size);
+        sport_statistics.emplace_back(std::make_tuple(size, str_sort, time));
+        std::cout << "Done.\n";
+
+        str_sort = "HeapSort (sport strings)";
+        std::cout << "Running " << str_sort << "..." << std::flush;
+        time = get_time_sort(heap_sort_strings, data, size);
+        sport_statistics.emplace_back(std::make_tuple(size, str_sort, time));
+        std::cout << "Done.\n";
+    }
+
+    times_to_csv("sport_code_times.csv", sport_statistics);
+
+    // Сортировка по нормализованным ключам против сравнения записей operator<
+    std::vector<my_tuple> key_statistics;
+    auto q_sort_keys = [](Data::iterator first, Data::iterator last)
+    {
+        study::key_sort(first, last, [](auto items_first, auto items_last, auto cmp)
+        {
+            study::q_sort(items_first, items_last, cmp);
+        });
+    };
+    auto heap_sort_keys = [](Data::iterator first, Data::iterator last)
+    {
+        study::key_sort(first, last, [](auto items_first, auto items_last, auto cmp)
+        {
+            study::heap_sort(items_first, items_last, cmp);
+        });
+    };
+
+    for (std::size_t size : sizes)
+    {
+        std::cout << "-----Size: " << size << "------\n";
+
+        std::string str_sort = "QuickSort";
+        std::cout << "Running " << str_sort << "..." << std::flush;
+        time = get_time_sort(study::q_sort<Data::iterator>, data, size);
+        key_statistics.emplace_back(std::make_tuple(size, str_sort, time));
+        std::cout << "Done.\n";
+
+        str_sort = "QuickSort (normalized keys)";
+        std::cout << "Running " << str_sort << "..." << std::flush;
+        time = get_time_sort(q_sort_keys, data, size);
+        key_statistics.emplace_back(std::make_tuple(size, str_sort, time));
+        std::cout << "Done.\n";
+
+        str_sort = "HeapSort";
+        std::cout << "Running " << str_sort << "..." << std::flush;
+        time = get_time_sort(study::heap_sort<Data::iterator>, data, size);
+        key_statistics.emplace_back(std::make_tuple(size, str_sort, time));
+        std::cout << "Done.\n";
+
+        str_sort = "HeapSort (normalized keys)";
+        std::cout << "Running " << str_sort << "..." << std::flush;
+        time = get_time_sort(heap_sort_keys, data, size);
+        key_statistics.emplace_back(std::make_tuple(size, str_sort, time));
+        std::cout << "Done.\n";
+    }
+
+    times_to_csv("sort_key_times.csv", key_statistics);
+
+    // Сортировки на упорядоченных, обратно упорядоченных данных и данных с малым числом различных записей
+    std::vector<my_tuple> order_statistics;
+    Data sorted_data = data;
+    std::sort(sorted_data.begin(), sorted_data.end());
+    Data reversed_data(sorted_data.rbegin(), sorted_data.rend());
+    Data few_unique_data;
+    few_unique_data.reserve(data.size());
+    for (std::size_t i = 0; i < data.size(); ++i)
+        few_unique_data.push_back(data[i % 8]);
+
+    std::vector<std::pair<std::string, const Data*>> inputs = {
+        {"random", &data}, {"sorted", &sorted_data}, {"reversed", &reversed_data}, {"few unique", &few_unique_data}};
+
+    for (std::size_t size : sizes)
+    {
+        std::cout << "-----Size: " << size << "------\n";
+        for (const auto& [input_name, input] : inputs)
+        {
+            std::string str_sort = "QuickSort (" + input_name + ")";
+            std::cout << "Running " << str_sort << "..." << std::flush;
+            time = get_time_sort(study::q_sort<Data::iterator>, *input, size);
+            order_statistics.emplace_back(std::make_tuple(size, str_sort, time));
+            std::cout << "Done.\n";
+
+            str_sort = "HeapSort (" + input_name + ")";
+            std::cout << "Running " << str_sort << "..." << std::flush;
+            time = get_time_sort(study::heap_sort<Data::iterator>, *input, size);
+            order_statistics.emplace_back(std::make_tuple(size, str_sort, time));
+            std::cout << "Done.\n";
+        }
+    }
+
+    times_to_csv("input_order_times.csv", order_statistics);
+
+    // Запись отсортированных данных: data_to_csv против буферизованной записи
+    std::vector<my_tuple> write_statistics;
+    std::vector<std::pair<std::string, std::function<void(const std::string&, const Data&)>>> writers = {
+        {"data_to_csv", [](const std::string& file, const Data& rows) { data_to_csv(file, rows); }},
+        {"buffered", [](const std::string& file, const Data& rows) { data_to_csv_buffered(file, rows); }},
+        {"buffered parallel", [](const std::string& file, const Data& rows) { data_to_csv_buffered(file, rows, 0); }}};
+
+    for (std::size_t rows : {data.size(), std::size_t(10000000)})
+    {
+        std::cout << "-----Rows: " << rows << "------\n";
+        Data sorted;
+        sorted.reserve(rows);
+        for (std::size_t i = 0; i < rows; ++i)
+            sorted.push_back(data[i % data.size()]);
+        study::q_sort(sorted.begin(), sorted.end());
+
+        for (const auto& [writer_name, writer] : writers)
+        {
+            std::cout << "Running " << writer_name << "..." << std::flush;
+            time = get_time_write(writer, "sorted.csv", sorted);
+            write_statistics.emplace_back(std::make_tuple(rows, writer_name, time));
+            std::cout << "Done.\n";
+        }
+    }
+    times_to_csv("write_times.csv", write_statistics);
+
 }
@@ -0,0 +1,217 @@
+/**
+ * @file
+ * @brief Файл, содержащий нормализованные ключи сортировки записей Entry.
+ * @details Ключ записи -- строка байт, которая сравнивается как memcmp в том же порядке,
+ * что и operator< для Entry: вид спорта, имя, возраст. Первые 8 байт ключа хранятся
+ * отдельно как число (префикс), поэтому большинство сравнений -- сравнение двух чисел.
+ */
+
+#pragma once
+
+#include "entry.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace study
+{
+    /**
+     * Нормализованные ключи сортировки для набора записей
+     * @details Ключ состоит из:
+     * - номера вида спорта среди различных видов спорта набора (1, 2 или 4 байта, big-endian).
+     * Номера упорядочены по кодам SportDictionary, а если у каких-то записей коды несравнимы, --
+     * по строкам видов спорта;
+     * - байт имени, где '\0' заменен на "\0\xff", и завершающих "\0\0", чтобы более короткое
+     * имя было меньше своего продолжения;
+     * - возраста: 4 байта big-endian с инвертированным знаковым битом.
+     * Сравнение записей сводится к сравнению префиксов и, только при равных префиксах,
+     * к сравнению полных ключей.
+     */
+    class SortKeys
+    {
+    public:
+        /**
+         * Элемент, который переставляет сортировка: префикс ключа и номер записи
+         */
+        struct Item
+        {
+            std::uint64_t prefix;
+            std::uint32_t index;
+        };
+
+        /**
+         * Строит ключи записей диапазона
+         * @tparam Iterator
+         * @param[in] first, last итераторы, указывающие на диапазон записей
+         */
+        template<typename Iterator>
+        SortKeys(Iterator first, Iterator last)
+        {
+            const std::vector<std::uint32_t> ranks = sport_ranks(first, last);
+            std::uint32_t sport_count = 0;
+            for (std::uint32_t rank : ranks)
+                sport_count = std::max(sport_count, rank + 1);
+            const std::size_t rank_bytes = sport_count <= (1u << 8) ? 1 : sport_count <= (1u << 16) ? 2 : 4;
+
+            std::size_t total_size = 0;
+            for (Iterator it = first; it != last; ++it)
+                total_size += rank_bytes + it->getName().size() + 6;
+            bytes_.reserve(total_size);
+            offsets_.reserve(ranks.size() + 1);
+            items_.reserve(ranks.size());
+            offsets_.push_back(0);
+            for (std::size_t i = 0; first != last; ++first, ++i)
+            {
+                const std::size_t key_first = bytes_.size();
+                append_big_endian(ranks[i], rank_bytes);
+                const Entry::Name& name = first->getName();
+                if (name.find('\0') == Entry::Name::npos)
+                    bytes_ += name;
+                else
+                    for (char c : name)
+                    {
+                        bytes_ += c;
+                        if (c == '\0')
+                            bytes_ += '\xff';
+                    }
+                bytes_ += '\0';
+                bytes_ += '\0';
+                append_big_endian(static_cast<std::uint32_t>(first->getAge()) ^ 0x80000000u, 4);
+                offsets_.push_back(bytes_.size());
+
+                items_.push_back({prefix_of(bytes_.data() + key_first, bytes_.size() - key_first),
+                                  static_cast<std::uint32_t>(i)});
+            }
+        }
+
+        /**
+         * Полный ключ записи с номером index
+         */
+        std::string_view key(std::uint32_t index) const
+        {
+            return std::string_view(bytes_.data() + offsets_[index], offsets_[index + 1] - offsets_[index]);
+        }
+
+        /**
+         * Проверяет, должен ли элемент lhs стоять левее rhs
+         */
+        bool less(const Item& lhs, const Item& rhs) const
+        {
+            if (lhs.prefix != rhs.prefix)
+                return lhs.prefix < rhs.prefix;
+            return key(lhs.index) < key(rhs.index);
+        }
+
+        /**
+         * Элементы для сортировки, по одному на запись, в исходном порядке записей
+         */
+        std::vector<Item>& items() { return items_; }
+
+    private:
+        /**
+         * Номера видов спорта записей среди различных видов спорта, в порядке operator<
+         */
+        template<typename Iterator>
+        static std::vector<std::uint32_t> sport_ranks(Iterator first, Iterator last)
+        {
+            bool all_coded = true;
+            for (Iterator it = first; it != last && all_coded; ++it)
+                all_coded = SportDictionary::comparable(it->getSportCode(), first->getSportCode());
+
+            std::vector<std::uint32_t> ranks;
+            if (all_coded)
+                ranks_by(first, last, ranks, [](const auto& entry) { return entry.getSportCode(); });
+            else
+                ranks_by(first, last, ranks, [](const auto& entry) { return std::string_view(entry.getSport()); });
+            return ranks;
+        }
+
+        /**
+         * Номера значений extractor(запись) среди различных значений, в порядке значений
+         * @details Сначала записи получают номера различных значений в порядке появления,
+         * затем эти номера заменяются на места значений после сортировки.
+         */
+        template<typename Iterator, typename Extractor>
+        static void ranks_by(Iterator first, Iterator last, std::vector<std::uint32_t>& ranks, Extractor extractor)
+        {
+            using Value = decltype(extractor(*first));
+            std::unordered_map<Value, std::uint32_t> seen;
+            std::vector<Value> distinct;
+            for (Iterator it = first; it != last; ++it)
+            {
+                const Value value = extractor(*it);
+                auto inserted = seen.emplace(value, static_cast<std::uint32_t>(distinct.size()));
+                if (inserted.second)
+                    distinct.push_back(value);
+                ranks.push_back(inserted.first->second);
+            }
+
+            std::vector<std::uint32_t> order(distinct.size());
+            for (std::uint32_t i = 0; i < order.size(); ++i)
+                order[i] = i;
+            std::sort(order.begin(), order.end(), [&distinct](std::uint32_t lhs, std::uint32_t rhs)
+            {
+                return distinct[lhs] < distinct[rhs];
+            });
+            std::vector<std::uint32_t> place(distinct.size());
+            for (std::uint32_t i = 0; i < order.size(); ++i)
+                place[order[i]] = i;
+            for (std::uint32_t& rank : ranks)
+                rank = place[rank];
+        }
+
+        void append_big_endian(std::uint32_t value, std::size_t bytes)
+        {
+            for (std::size_t i = bytes; i-- > 0; )
+                bytes_ += static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+
+        /**
+         * Первые 8 байт ключа как число big-endian; короткий ключ дополняется нулями
+         */
+        static std::uint64_t prefix_of(const char* key, std::size_t size)
+        {
+            std::uint64_t prefix = 0;
+            for (std::size_t i = 0; i < 8; ++i)
+                prefix = (prefix << 8) | (i < size ? static_cast<unsigned char>(key[i]) : 0u);
+            return prefix;
+        }
+
+        std::string bytes_;                 //Все ключи подряд
+        std::vector<std::size_t> offsets_;  //Ключ записи i -- [offsets_[i], offsets_[i + 1])
+        std::vector<Item> items_;
+    };
+
+    /**
+     * Сортирует записи в порядке operator< с помощью нормализованных ключей
+     * @details Строятся ключи SortKeys, сортировка sort переставляет только пары
+     * (префикс, номер записи), а записи переставляются один раз в конце.
+     * @tparam Iterator
+     * @tparam Sort функция сортировки вида sort(first, last, cmp), например study::q_sort
+     * @param[in,out] first, last итераторы, указывающие на диапазон, который нужно отсортировать
+     * @param[in] sort функция сортировки
+     */
+    template<typename Iterator, typename Sort>
+    void key_sort(Iterator first, Iterator last, Sort sort)
+    {
+        SortKeys keys(first, last);
+        std::vector<SortKeys::Item>& items = keys.items();
+        sort(items.begin(), items.end(), [&keys](const SortKeys::Item& lhs, const SortKeys::Item& rhs)
+        {
+            return keys.less(lhs, rhs);
+        });
+
+        using value_type = typename std::iterator_traits<Iterator>::value_type;
+        std::vector<value_type> sorted;
+        sorted.reserve(items.size());
+        for (const SortKeys::Item& item : items)
+            sorted.push_back(std::move(*std::next(first, item.index)));
+        std::move(sorted.begin(), sorted.end(), first);
+    }
+}
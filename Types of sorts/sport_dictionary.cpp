@@ -0,0 +1,61 @@
+/**
+  * @file
+  * @brief Файл исходного кода, содержащий определения методов класса SportDictionary
+  */
+
+#include "sport_dictionary.h"
+#include <atomic>
+
+SportDictionary::SportDictionary()
+{
+    // Номер 0 не выдается, чтобы код словаря никогда не совпадал с no_code
+    static std::atomic<std::uint32_t> next_id{0};
+    std::uint32_t id;
+    do
+        id = ++next_id;
+    while (id == 0);
+    id_ = static_cast<Code>(id) << 32;
+}
+
+void SportDictionary::intern(const std::vector<std::string_view>& sports)
+{
+    bool added = false;
+    for (std::string_view sport : sports)
+        added |= codes_.emplace(std::string(sport), 0).second;
+    if (!added)
+        return;
+
+    // Каждая серия видов спорта без кода получает коды, равномерно распределенные
+    // между кодами соседей; high не входит в диапазон допустимых кодов
+    std::uint64_t low = 0;
+    for (auto it = codes_.begin(); it != codes_.end(); )
+    {
+        if (it->second != 0)
+        {
+            low = it->second;
+            ++it;
+            continue;
+        }
+        auto run_end = it;
+        std::uint64_t count = 0;
+        while (run_end != codes_.end() && run_end->second == 0)
+        {
+            ++run_end;
+            ++count;
+        }
+        const std::uint64_t high = run_end != codes_.end() ? run_end->second : std::uint64_t(1) << 32;
+        const std::uint64_t step = (high - low) / (count + 1);
+        if (step != 0)
+            for (std::uint64_t i = 1; it != run_end; ++it, ++i)
+                it->second = static_cast<std::uint32_t>(low + step * i);
+        it = run_end;
+    }
+}
+
+SportDictionary::Code SportDictionary::code(std::string_view sport) const
+{
+    auto it = codes_.find(sport);
+    if (it == codes_.end() || it->second == 0)
+        return no_code;
+    return id_ | it->second;
+}
@@ -0,0 +1,99 @@
+/**
+  * @file
+  * @brief Заголовочный файл, содержащий определение класса SportDictionary -- словаря видов спорта
+  */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class SportDictionary
+ * @brief Сопоставляет каждому виду спорта целочисленный код, порядок кодов совпадает с порядком строк
+ * @details Код состоит из номера словаря (старшие 32 бита) и порядкового кода вида спорта
+ * (младшие 32 бита). Коды сравнимы, только если выданы одним словарем (см. comparable),
+ * поэтому записи разных наборов данных не перепутают порядок.
+ * Новые виды спорта, попавшие между двумя соседями по алфавиту, получают коды, равномерно
+ * распределенные между кодами соседей, поэтому выданные коды никогда не меняются. Если
+ * между соседями не осталось свободных кодов, выдается no_code, и такие записи
+ * сравниваются по строкам.
+ * Словарь не потокобезопасен: коды назначаются один раз после загрузки набора данных (encode),
+ * а конструктор Entry словарем не пользуется.
+ */
+class SportDictionary
+{
+public:
+    using Code = std::uint64_t;
+
+    static constexpr Code no_code = 0;
+
+    SportDictionary();
+
+    /**
+     * @brief Проверяет, можно ли сравнивать коды lhs и rhs как числа
+     * @return true, если оба кода выданы и выданы одним словарем
+     */
+    static bool comparable(Code lhs, Code rhs)
+    {
+        return lhs != no_code && rhs != no_code && (lhs >> 32) == (rhs >> 32);
+    }
+
+    /**
+     * @brief Назначает коды видов спорта записям диапазона
+     * @details Каждая строка вида спорта ищется в хеш-таблице один раз на запись,
+     * а в словарь добавляется один раз на различный вид спорта.
+     * @tparam Iterator итератор по записям Entry
+     * @param[in,out] first, last итераторы, указывающие на диапазон записей
+     */
+    template<typename Iterator>
+    void encode(Iterator first, Iterator last)
+    {
+        std::unordered_map<std::string_view, std::uint32_t> seen;
+        std::vector<std::string_view> distinct;
+        std::vector<std::uint32_t> indices;
+        for (Iterator it = first; it != last; ++it)
+        {
+            auto inserted = seen.emplace(it->getSport(), static_cast<std::uint32_t>(distinct.size()));
+            if (inserted.second)
+                distinct.push_back(inserted.first->first);
+            indices.push_back(inserted.first->second);
+        }
+
+        intern(distinct);
+        std::vector<Code> codes;
+        codes.reserve(distinct.size());
+        for (std::string_view sport : distinct)
+            codes.push_back(code(sport));
+
+        std::size_t i = 0;
+        for (Iterator it = first; it != last; ++it, ++i)
+            it->setSportCode(codes[indices[i]]);
+    }
+
+    /**
+     * @brief Добавляет в словарь виды спорта, которых в нем еще нет
+     * @param[in] sports виды спорта, в любом порядке
+     */
+    void intern(const std::vector<std::string_view>& sports);
+
+    /**
+     * @brief Код вида спорта
+     * @return код или no_code, если вида спорта нет в словаре или для него не нашлось свободного кода
+     */
+    Code code(std::string_view sport) const;
+
+    /**
+     * @brief Число видов спорта в словаре
+     */
+    std::size_t size() const { return codes_.size(); }
+
+private:
+    Code id_;
+    std::map<std::string, std::uint32_t, std::less<>> codes_;  //Порядковые коды; 0 -- кода нет
+};
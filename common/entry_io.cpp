@@ -0,0 +1,320 @@
+/**
+ * @file
+ * @brief Файл исходного кода, содержащий быстрое чтение и запись наборов записей Entry
+ */
+
+#include "entry_io.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+/**
+ * @brief Разбирает строки csv из диапазона [first, last) и добавляет записи в data
+ */
+void parse_csv_range(const char* first, const char* last, char sep, Data& data)
+{
+    parse_csv_lines(first, last, sep, [&data](std::string_view name, Entry::Age age, Entry::Height height,
+                                              Entry::Weight weight, std::string_view sport)
+    {
+        data.emplace_back(Entry::Name(name), age, height, weight, Entry::Sport(sport));
+    });
+}
+} // namespace
+
+std::size_t count_csv_lines(const char* first, const char* last)
+{
+    std::size_t lines = 0;
+    for (const char* p = first; p != last; ++lines)
+    {
+        p = csv_detail::find_char(p, last, '\n');
+        if (p != last)
+            ++p;
+    }
+    return lines;
+}
+
+Entry entry_from_csv_line(const char* first, const char* last, char sep)
+{
+    return csv_detail::parse_csv_line(first, last, sep, [](std::string_view name, Entry::Age age, Entry::Height height,
+                                                           Entry::Weight weight, std::string_view sport)
+    {
+        return Entry(Entry::Name(name), age, height, weight, Entry::Sport(sport));
+    });
+}
+
+Data data_from_csv_mmap(const std::string& filename, char sep)
+{
+    MappedFile file(filename, true);
+
+    // Число строк считается заранее, чтобы вектор не перевыделялся
+    Data vec;
+    vec.reserve(count_csv_lines(file.begin(), file.end()));
+    parse_csv_range(file.begin(), file.end(), sep, vec);
+    return vec;
+}
+
+Data data_from_csv_parallel(const std::string& filename, std::size_t thread_count, char sep)
+{
+    MappedFile file(filename, true);
+    if (thread_count == 0)
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+    // Слишком мелкие куски не окупают создание потока
+    constexpr std::size_t min_chunk_size = 1 << 16;
+    const std::size_t size = static_cast<std::size_t>(file.end() - file.begin());
+    thread_count = std::min(thread_count, std::max<std::size_t>(1, size / min_chunk_size));
+
+    // Границы кусков сдвигаются вперед до начала следующей строки
+    std::vector<const char*> bounds = {file.begin()};
+    for (std::size_t t = 1; t < thread_count; ++t)
+    {
+        const char* bound = std::max(bounds.back(), file.begin() + size / thread_count * t);
+        if (bound != file.begin() && bound != file.end() && bound[-1] != '\n')
+        {
+            bound = csv_detail::find_char(bound, file.end(), '\n');
+            if (bound != file.end())
+                ++bound;
+        }
+        bounds.push_back(bound);
+    }
+    bounds.push_back(file.end());
+
+    const std::size_t chunk_count = bounds.size() - 1;
+    std::vector<Data> chunks(chunk_count);
+    std::vector<std::exception_ptr> errors(chunk_count);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < chunk_count; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            try
+            {
+                parse_csv_range(bounds[t], bounds[t + 1], sep, chunks[t]);
+            }
+            catch (...)
+            {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    for (const std::exception_ptr& error : errors)
+        if (error)
+            std::rethrow_exception(error);
+
+    // Куски склеиваются в исходном порядке строк; записи перемещаются, а не копируются
+    std::size_t total = 0;
+    for (const Data& chunk : chunks)
+        total += chunk.size();
+    Data vec = std::move(chunks[0]);
+    vec.reserve(total);
+    for (std::size_t t = 1; t < chunk_count; ++t)
+        vec.insert(vec.end(), std::make_move_iterator(chunks[t].begin()), std::make_move_iterator(chunks[t].end()));
+    return vec;
+}
+
+namespace
+{
+/**
+ * @brief Заголовок двоичного файла с данными (см. data_to_bin)
+ */
+struct BinHeader
+{
+    char magic[8];                  //"ENTRYBIN"
+    std::uint32_t version;
+    std::uint32_t byte_order;       //bin_byte_order в порядке байтов записавшей машины
+    std::uint64_t rows;
+    std::uint64_t sports;           //Число различных видов спорта
+    std::uint64_t heap_size;        //Размер кучи строк в байтах
+    std::uint64_t columns_checksum;
+    std::uint64_t heap_checksum;
+    std::uint64_t header_checksum;  //Контрольная сумма всех предыдущих полей заголовка
+};
+
+constexpr char bin_magic[8] = {'E', 'N', 'T', 'R', 'Y', 'B', 'I', 'N'};
+constexpr std::uint32_t bin_version = 1;
+constexpr std::uint32_t bin_byte_order = 0x01020304;
+
+/**
+ * @brief Контрольная сумма: FNV-1a по 8-байтовым словам с перемешиванием старших бит
+ */
+std::uint64_t bin_checksum(const char* data, std::size_t size)
+{
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 0x100000001b3ull;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; ++i)
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ull;
+    return hash ^ size;
+}
+
+/**
+ * @brief Дописывает значение в буфер побайтово
+ */
+template <typename T>
+void append_bytes(std::string& buffer, const T& value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * @brief Читает значение из буфера (адрес может быть не выровнен)
+ */
+template <typename T>
+T load_bytes(const char* pos)
+{
+    T value;
+    std::memcpy(&value, pos, sizeof(T));
+    return value;
+}
+} // namespace
+
+void data_to_bin(const std::string& filename, const Data& data)
+{
+    // Виды спорта хранятся в куче по одному разу, в столбце -- их номера
+    std::unordered_map<std::string, std::uint32_t> sport_codes;
+    std::vector<const Entry::Sport*> sports;
+    std::string names;
+    for (const Entry& entry : data)
+    {
+        names += entry.getName();
+        if (sport_codes.emplace(entry.getSport(), static_cast<std::uint32_t>(sports.size())).second)
+            sports.push_back(&entry.getSport());
+    }
+
+    std::string columns;
+    columns.reserve(data.size() * (4 * sizeof(std::int32_t) + sizeof(std::uint64_t)) + (sports.size() + 2) * sizeof(std::uint64_t));
+    for (const Entry& entry : data)
+        append_bytes(columns, static_cast<std::int32_t>(entry.getAge()));
+    for (const Entry& entry : data)
+        append_bytes(columns, static_cast<std::int32_t>(entry.getHeight()));
+    for (const Entry& entry : data)
+        append_bytes(columns, static_cast<std::int32_t>(entry.getWeight()));
+    for (const Entry& entry : data)
+        append_bytes(columns, sport_codes.find(entry.getSport())->second);
+
+    std::uint64_t offset = 0;
+    append_bytes(columns, offset);
+    for (const Entry& entry : data)
+    {
+        offset += entry.getName().size();
+        append_bytes(columns, offset);
+    }
+    std::string heap = std::move(names);
+    append_bytes(columns, static_cast<std::uint64_t>(heap.size()));
+    for (const Entry::Sport* sport : sports)
+    {
+        heap += *sport;
+        append_bytes(columns, static_cast<std::uint64_t>(heap.size()));
+    }
+
+    BinHeader header{};
+    std::memcpy(header.magic, bin_magic, sizeof(bin_magic));
+    header.version = bin_version;
+    header.byte_order = bin_byte_order;
+    header.rows = data.size();
+    header.sports = sports.size();
+    header.heap_size = heap.size();
+    header.columns_checksum = bin_checksum(columns.data(), columns.size());
+    header.heap_checksum = bin_checksum(heap.data(), heap.size());
+    header.header_checksum = bin_checksum(reinterpret_cast<const char*>(&header), offsetof(BinHeader, header_checksum));
+
+    std::ofstream f(filename, std::ios::binary);
+    if (!f.is_open()) throw std::runtime_error("Cannot open output binary file");
+    f.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    f.write(columns.data(), static_cast<std::streamsize>(columns.size()));
+    f.write(heap.data(), static_cast<std::streamsize>(heap.size()));
+    if (!f) throw std::runtime_error("Cannot write output binary file");
+}
+
+Data data_from_bin(const std::string& filename)
+{
+    MappedFile file(filename, true);
+    const std::size_t size = static_cast<std::size_t>(file.end() - file.begin());
+    if (size < sizeof(BinHeader))
+        throw std::runtime_error("Invalid binary data file: too short");
+
+    const BinHeader header = load_bytes<BinHeader>(file.begin());
+    if (std::memcmp(header.magic, bin_magic, sizeof(bin_magic)) != 0)
+        throw std::runtime_error("Invalid binary data file: wrong magic");
+    if (header.byte_order != bin_byte_order)
+        throw std::runtime_error("Invalid binary data file: wrong byte order");
+    if (header.version != bin_version)
+        throw std::runtime_error("Invalid binary data file: unsupported version");
+    if (header.header_checksum != bin_checksum(reinterpret_cast<const char*>(&header), offsetof(BinHeader, header_checksum)))
+        throw std::runtime_error("Invalid binary data file: header checksum mismatch");
+
+    const std::uint64_t rows = header.rows;
+    const std::uint64_t max_rows = size / (4 * sizeof(std::int32_t) + sizeof(std::uint64_t));
+    if (rows > max_rows || header.sports > size / sizeof(std::uint64_t) || header.heap_size > size)
+        throw std::runtime_error("Invalid binary data file: wrong size");
+    const std::size_t columns_size = rows * (4 * sizeof(std::int32_t) + sizeof(std::uint64_t))
+                                   + (header.sports + 2) * sizeof(std::uint64_t);
+    if (sizeof(BinHeader) + columns_size + header.heap_size != size)
+        throw std::runtime_error("Invalid binary data file: wrong size");
+
+    const char* ages = file.begin() + sizeof(BinHeader);
+    const char* heights = ages + rows * sizeof(std::int32_t);
+    const char* weights = heights + rows * sizeof(std::int32_t);
+    const char* codes = weights + rows * sizeof(std::int32_t);
+    const char* name_offsets = codes + rows * sizeof(std::uint32_t);
+    const char* sport_offsets = name_offsets + (rows + 1) * sizeof(std::uint64_t);
+    const char* heap = sport_offsets + (header.sports + 1) * sizeof(std::uint64_t);
+    if (bin_checksum(ages, columns_size) != header.columns_checksum)
+        throw std::runtime_error("Invalid binary data file: columns checksum mismatch");
+    if (bin_checksum(heap, header.heap_size) != header.heap_checksum)
+        throw std::runtime_error("Invalid binary data file: heap checksum mismatch");
+
+    // Строки берутся из кучи по смещениям, поэтому смещения проверяются на монотонность
+    auto heap_string = [&header, heap](const char* offsets, std::uint64_t i)
+    {
+        const std::uint64_t first = load_bytes<std::uint64_t>(offsets + i * sizeof(std::uint64_t));
+        const std::uint64_t last = load_bytes<std::uint64_t>(offsets + (i + 1) * sizeof(std::uint64_t));
+        if (first > last || last > header.heap_size)
+            throw std::runtime_error("Invalid binary data file: wrong string offset");
+        return std::string(heap + first, heap + last);
+    };
+    std::vector<Entry::Sport> sports;
+    sports.reserve(header.sports);
+    for (std::uint64_t i = 0; i < header.sports; ++i)
+        sports.push_back(heap_string(sport_offsets, i));
+
+    Data vec;
+    vec.reserve(rows);
+    for (std::uint64_t i = 0; i < rows; ++i)
+    {
+        const std::uint32_t code = load_bytes<std::uint32_t>(codes + i * sizeof(std::uint32_t));
+        if (code >= sports.size())
+            throw std::runtime_error("Invalid binary data file: wrong sport code");
+        vec.emplace_back(heap_string(name_offsets, i),
+                         load_bytes<std::int32_t>(ages + i * sizeof(std::int32_t)),
+                         load_bytes<std::int32_t>(heights + i * sizeof(std::int32_t)),
+                         load_bytes<std::int32_t>(weights + i * sizeof(std::int32_t)),
+                         sports[code]);
+    }
+    return vec;
+}
+
+void csv_to_bin(const std::string& csv_filename, const std::string& bin_filename, char sep)
+{
+    data_to_bin(bin_filename, data_from_csv_mmap(csv_filename, sep));
+}
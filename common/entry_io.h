@@ -0,0 +1,163 @@
+/**
+ * @file
+ * @brief Заголовочный файл, содержащий быстрое чтение и запись наборов записей Entry:
+ * csv-файл, отображенный в память, и двоичный формат
+ * @details Файл общий для всех лабораторных работ и собирается вместе с entry.h
+ * каждой из них (см. CMakeLists.txt лабораторных).
+ */
+
+#pragma once
+
+#include "entry.h"
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+using Data = std::vector<Entry>;
+
+namespace csv_detail
+{
+/**
+ * @brief Ищет символ c в [first, last) с помощью memchr
+ * @return указатель на символ или last, если его нет
+ */
+inline const char* find_char(const char* first, const char* last, char c)
+{
+    const void* p = std::memchr(first, c, static_cast<std::size_t>(last - first));
+    return p ? static_cast<const char*>(p) : last;
+}
+
+/**
+ * @brief Разбирает целое число до разделителя и сдвигает pos за разделитель
+ */
+template <typename Int>
+Int parse_csv_number(const char*& pos, const char* end, char sep, const char* error)
+{
+    Int value{};
+    const std::from_chars_result result = std::from_chars(pos, end, value);
+    if (result.ec != std::errc() || result.ptr == end || *result.ptr != sep)
+        throw std::runtime_error(error);
+    pos = result.ptr + 1;
+    return value;
+}
+
+/**
+ * @brief Разбирает одну строку csv [first, last) (без символа '\n') и передает ее поля в emit
+ * @details Формат и ошибки те же, что у get_line_from_csv: спорт -- все до следующего
+ * разделителя или до конца строки (включая '\r', если файл с концами строк CRLF).
+ * @param[in] emit функция emit(name, age, height, weight, sport), где name и sport --
+ * std::string_view, указывающие в [first, last)
+ */
+template <typename Emit>
+auto parse_csv_line(const char* first, const char* last, char sep, Emit emit)
+{
+    const char* name_end = find_char(first, last, sep);
+    if (name_end == last)
+        throw std::runtime_error("Invalid input \"age\" from csv. Wrong separator or format of number.");
+    const char* pos = name_end + 1;
+
+    const Entry::Age age = parse_csv_number<Entry::Age>(pos, last, sep,
+            "Invalid input \"age\" from csv. Wrong separator or format of number.");
+    const Entry::Height height = parse_csv_number<Entry::Height>(pos, last, sep,
+            "Invalid input \"height\" from csv. Wrong separator or format of number.");
+    const Entry::Weight weight = parse_csv_number<Entry::Weight>(pos, last, sep,
+            "Invalid input \"weight\" from csv. Wrong separator or format of number");
+
+    const char* sport_end = find_char(pos, last, sep);
+    return emit(std::string_view(first, static_cast<std::size_t>(name_end - first)), age, height, weight,
+                std::string_view(pos, static_cast<std::size_t>(sport_end - pos)));
+}
+} // namespace csv_detail
+
+/**
+ * @brief Считывает данные из csv-файла так же, как data_from_csv, но без построчного
+ * копирования: файл отображается в память (POSIX mmap), разделители ищутся memchr,
+ * числа разбираются std::from_chars, а записи создаются сразу в векторе
+ * @param[in] filename имя/путь к файлу с данными для чтения
+ * @param[in] sep использующийся в csv-файле разделитель
+ * @return вектор из объектов класса Entry, определенного в "entry.h"
+ */
+Data data_from_csv_mmap(const std::string& filename, char sep=',');
+
+/**
+ * @brief Разбирает одну строку csv-файла так же, как get_line_from_csv, но без копирования
+ * строки в поток: числа разбираются std::from_chars
+ * @param[in] first, last указатели на начало и конец строки (без символа '\n')
+ * @param[in] sep использующийся в csv-файле разделитель
+ * @return объект класса Entry
+ */
+Entry entry_from_csv_line(const char* first, const char* last, char sep=',');
+
+/**
+ * @brief Разбирает строки csv из диапазона [first, last) и передает поля каждой строки в emit
+ * @details Формат и ошибки те же, что у get_line_from_csv: спорт -- все до следующего
+ * разделителя или до конца строки (включая '\r', если файл с концами строк CRLF).
+ * @param[in] first, last указатели на начало и конец текста csv
+ * @param[in] sep использующийся в csv-файле разделитель
+ * @param[in] emit функция emit(name, age, height, weight, sport), где name и sport --
+ * std::string_view, указывающие в [first, last)
+ */
+template <typename Emit>
+void parse_csv_lines(const char* first, const char* last, char sep, Emit emit)
+{
+    while (first != last)
+    {
+        const char* line_end = csv_detail::find_char(first, last, '\n');
+        csv_detail::parse_csv_line(first, line_end, sep, emit);
+        first = line_end == last ? last : line_end + 1;
+    }
+}
+
+/**
+ * @brief Считает строки текста csv, чтобы заранее зарезервировать место под записи
+ * @param[in] first, last указатели на начало и конец текста csv
+ * @return число строк; последняя строка может не заканчиваться '\n'
+ */
+std::size_t count_csv_lines(const char* first, const char* last);
+
+/**
+ * @brief Считывает данные из csv-файла в несколько потоков
+ * @details Отображенный в память файл делится на куски по границам строк, каждый
+ * кусок разбирается своим потоком в свой вектор (как в data_from_csv_mmap), затем
+ * векторы склеиваются в исходном порядке строк.
+ * @param[in] filename имя/путь к файлу с данными для чтения
+ * @param[in] thread_count число потоков; 0 -- по числу ядер
+ * @param[in] sep использующийся в csv-файле разделитель
+ * @return вектор из объектов класса Entry, определенного в "entry.h"
+ */
+Data data_from_csv_parallel(const std::string& filename, std::size_t thread_count=0, char sep=',');
+
+/**
+ * @brief Записывает данные в двоичный файл, который читается без разбора текста
+ * @details Формат (версия 1): заголовок BinHeader (сигнатура "ENTRYBIN", версия, метка
+ * порядка байтов, число строк и видов спорта, размер кучи строк, контрольные суммы),
+ * затем столбцы: возраст, рост и вес (int32), номер вида спорта (uint32), смещения имен
+ * в куче (uint64, строк + 1), смещения видов спорта в куче (uint64, видов спорта + 1), и
+ * наконец куча строк: все имена подряд, затем каждый вид спорта по одному разу.
+ * Числа записываются в порядке байтов машины; файл с другим порядком байтов не читается.
+ * @param[out] filename файл, в который будут записаны данные
+ * @param[in] data данные для записи в файл
+ */
+void data_to_bin(const std::string& filename, const Data& data);
+
+/**
+ * @brief Считывает данные из двоичного файла, записанного data_to_bin
+ * @param[in] filename имя/путь к файлу с данными для чтения
+ * @return вектор из объектов класса Entry, определенного в "entry.h"
+ * @throw std::runtime_error, если файл поврежден: не совпали сигнатура, версия,
+ * порядок байтов, размер или контрольные суммы
+ */
+Data data_from_bin(const std::string& filename);
+
+/**
+ * @brief Переводит csv-файл в двоичный формат data_to_bin
+ * @param[in] csv_filename исходный csv-файл
+ * @param[out] bin_filename двоичный файл
+ * @param[in] sep использующийся в csv-файле разделитель
+ */
+void csv_to_bin(const std::string& csv_filename, const std::string& bin_filename, char sep=',');
@@ -0,0 +1,40 @@
+/**
+ * @file
+ * Содержит отображение файла в память только для чтения (POSIX mmap)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+
+/**
+ * @brief Файл, отображенный в память только для чтения (POSIX mmap)
+ * @details Отображение снимается в деструкторе. Пустой файл не отображается: data() == nullptr, size() == 0.
+ */
+class MappedFile
+{
+public:
+    /**
+     * @param[in] filename имя файла
+     * @param[in] sequential файл будет читаться один раз от начала до конца (madvise MADV_SEQUENTIAL)
+     * @throw std::runtime_error, если файл не удалось открыть или отобразить
+     */
+    explicit MappedFile(const std::string& filename, bool sequential=false);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};